@@ -0,0 +1,252 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pbnjson.hpp>
+
+#include "base/Application.h"
+#include "base/ApplicationRegistry.h"
+#include "policy/KillPlanner.h"
+#include "util/Logger.h"
+#include "util/MemInfo.h"
+#include "util/Proc.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Application counts of the scaled benchmarks
+static const int APP_COUNTS[] = { 10, 100, 1000 };
+
+// Results are printed at once with '--json'
+static bool s_isJson = false;
+static JValue s_results = pbnjson::Array();
+
+static long long now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void report(const char* name, int apps, int iterations, long long elapsed)
+{
+    if (s_isJson) {
+        JValue result = pbnjson::Object();
+        result.put("name", name);
+        result.put("apps", apps);
+        result.put("iterations", iterations);
+        result.put("totalNs", (int64_t)elapsed);
+        result.put("sampleNs", (int64_t)(elapsed / iterations));
+        s_results.append(result);
+        return;
+    }
+
+    cout << "[bench] " << name << " : "
+         << "apps(" << apps << ") "
+         << "iterations(" << iterations << ") "
+         << "total(" << elapsed / 1000000 << "ms) "
+         << "sample(" << elapsed / iterations << "ns)" << endl;
+}
+
+// Work per iteration grows with the number of applications
+static int scale(int iterations, int apps)
+{
+    int scaled = iterations / apps;
+    return scaled > 0 ? scaled : 1;
+}
+
+// Parsing only, from a buffer read once
+static void benchMemInfoParse(int iterations)
+{
+    char buffer[8192];
+    FILE* fp = fopen(MemInfoReader::PATH, "r");
+    if (fp == NULL) {
+        cerr << "[bench] Failed to open " << MemInfoReader::PATH << endl;
+        return;
+    }
+    size_t size = fread(buffer, 1, sizeof(buffer), fp);
+    fclose(fp);
+
+    MemInfoSnapshot snapshot;
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        MemInfoReader::parse(buffer, size, snapshot);
+    }
+    report("meminfo.parse", 0, iterations, now() - start);
+}
+
+// pread + parse, which is the cost of a single sample in the daemon
+static void benchMemInfoRead(int iterations)
+{
+    MemInfoSnapshot snapshot;
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        Proc::getMemoryInfo(snapshot);
+    }
+    report("meminfo.read", 0, iterations, now() - start);
+}
+
+// The kernel walks all mappings of the process for each read
+static void benchSmapsRead(int iterations)
+{
+    SmapsRollupSnapshot snapshot;
+    pid_t pid = getpid();
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        Proc::getSmapsRollup(pid, snapshot);
+    }
+    report("smaps.read", 0, iterations, now() - start);
+}
+
+// All applications are this process, so that they have real memory usage.
+// The first one is foreground and every fifth one is preloaded.
+static void populate(ApplicationRegistry& registry, int apps)
+{
+    string pid = to_string(getpid());
+    for (int i = 0; i < apps; ++i) {
+        JValue json = pbnjson::Object();
+        json.put("id", "com.bench.app" + to_string(i));
+        json.put("processid", pid);
+        json.put("appType", (i % 2) ? "native" : "web");
+        json.put("event", i == 0 ? "foreground" : (i % 5 == 0 ? "preload" : "background"));
+
+        Application application;
+        application.fromJson(json);
+        registry.update(application, true);
+    }
+}
+
+// Status changes from getAppLifeEvents reorder the application
+static void benchRegistryUpdate(ApplicationRegistry& registry, int apps, int iterations)
+{
+    vector<Application> updates(apps);
+    for (int i = 0; i < apps; ++i) {
+        JValue json = pbnjson::Object();
+        json.put("id", "com.bench.app" + to_string(i));
+        json.put("event", (i % 3) ? "background" : "foreground");
+        updates[i].fromJson(json);
+    }
+
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        registry.update(updates[i % apps], true);
+    }
+    report("registry.update", apps, iterations, now() - start);
+}
+
+static void benchRegistryFind(ApplicationRegistry& registry, int apps, int iterations)
+{
+    vector<string> appIds;
+    for (int i = 0; i < apps; ++i) {
+        appIds.push_back("com.bench.app" + to_string(i));
+    }
+
+    int found = 0;
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        if (registry.find(appIds[i % apps]) != nullptr)
+            found++;
+    }
+    report("registry.find", apps, iterations, now() - start);
+    if (found != iterations)
+        cerr << "[bench] registry.find missed " << iterations - found << endl;
+}
+
+// Half of the reclaimable memory of all applications is required
+static void benchVictimPlan(ApplicationRegistry& registry, int apps, int iterations)
+{
+    long reclaimable = 0;
+    for (auto it = registry.begin(); it != registry.end(); ++it) {
+        reclaimable += (*it)->getReclaimable() / 1024;
+    }
+    int required = (int)(reclaimable / 2);
+    if (required <= 0)
+        required = 1;
+
+    iterations = scale(iterations, apps);
+    KillPlan plan;
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        KillPlanner::plan(registry, required, false, plan);
+    }
+    report("victim.plan", apps, iterations, now() - start);
+}
+
+// Same as 'applications' of getMemoryStatus
+static void benchStatusJson(ApplicationRegistry& registry, int apps, int iterations)
+{
+    iterations = scale(iterations, apps);
+    size_t size = 0;
+    long long start = now();
+    for (int i = 0; i < iterations; ++i) {
+        JValue payload = pbnjson::Object();
+        JValue array = pbnjson::Array();
+        for (auto it = registry.begin(); it != registry.end(); ++it) {
+            JValue item = pbnjson::Object();
+            (*it)->print(item);
+            array.append(item);
+        }
+        payload.put("applications", array);
+        size += payload.stringify().size();
+    }
+    report("status.json", apps, iterations, now() - start);
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 100000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0)
+            s_isJson = true;
+        else
+            iterations = atoi(argv[i]);
+    }
+    if (iterations <= 0) {
+        cerr << "[bench] #1 : Iterations - Default 100000" << endl;
+        cerr << "[bench] --json : Print results in JSON" << endl;
+        return 1;
+    }
+    Logger::getInstance().setLevel(LogLevel_ERROR);
+
+    benchMemInfoParse(iterations);
+    benchMemInfoRead(iterations);
+    benchSmapsRead(scale(iterations, 10));
+
+    for (size_t i = 0; i < sizeof(APP_COUNTS) / sizeof(APP_COUNTS[0]); ++i) {
+        int apps = APP_COUNTS[i];
+        ApplicationRegistry registry;
+        populate(registry, apps);
+
+        benchRegistryUpdate(registry, apps, iterations);
+        benchRegistryFind(registry, apps, iterations);
+        benchVictimPlan(registry, apps, iterations);
+        benchStatusJson(registry, apps, iterations);
+    }
+
+    if (s_isJson) {
+        JValue output = pbnjson::Object();
+        output.put("iterations", iterations);
+        output.put("results", s_results);
+        cout << output.stringify() << endl;
+    }
+    return 0;
+}
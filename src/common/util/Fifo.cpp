@@ -45,7 +45,7 @@ bool Fifo::open(string path, bool readonly)
     mkfifo(path.c_str(), 0666);
     m_fd = ::open(path.c_str(), O_RDWR);
     if (m_fd < 0) {
-        Logger::error(strerror(errno), LOG_NAME);
+        LOG_ERROR(strerror(errno), LOG_NAME);
         return false;
     }
     return true;
@@ -66,7 +66,7 @@ void Fifo::close()
 int Fifo::send(const void* buffer, int size)
 {
     if (m_readonly || m_fd < 0) {
-        Logger::error("Invalid write operation", LOG_NAME);
+        LOG_ERROR("Invalid write operation", LOG_NAME);
         return -1;
     }
     return ::write(m_fd, buffer, size);
@@ -75,7 +75,7 @@ int Fifo::send(const void* buffer, int size)
 int Fifo::receive(void *buffer, int size)
 {
     if (!m_readonly || m_fd < 0) {
-        Logger::error("Invalid read operation", LOG_NAME);
+        LOG_ERROR("Invalid read operation", LOG_NAME);
         return -1;
     }
     return ::read(m_fd, buffer, size);
@@ -0,0 +1,89 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "File.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Logger.h"
+#include "ProcFields.h"
+
+#define LOG_NAME "File"
+
+bool File::exists(const string& path)
+{
+    return (access(path.c_str(), F_OK) == 0);
+}
+
+bool File::readLong(const string& path, long& value)
+{
+    long long result;
+    if (!readLongLong(path, result))
+        return false;
+    value = (long)result;
+    return true;
+}
+
+bool File::readLongLong(const string& path, long long& value)
+{
+    char buffer[64];
+    ssize_t size = ProcFields::read(path.c_str(), buffer, sizeof(buffer) - 1);
+    if (size <= 0)
+        return false;
+    buffer[size] = '\0';
+
+    // cgroup files use 'max' for unlimited
+    if (strncmp(buffer, "max", 3) == 0) {
+        value = -1;
+        return true;
+    }
+
+    char* end;
+    value = strtoll(buffer, &end, 10);
+    return (end != buffer);
+}
+
+bool File::readString(const string& path, string& value)
+{
+    char buffer[4096];
+    ssize_t size = ProcFields::read(path.c_str(), buffer, sizeof(buffer));
+    if (size < 0)
+        return false;
+    value.assign(buffer, size);
+    return true;
+}
+
+bool File::write(const string& path, const string& value)
+{
+    // Kernel control files. A wrong path must fail instead of creating a file.
+    int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARNING("Failed to open " + path + " - " + strerror(errno), LOG_NAME);
+        return false;
+    }
+
+    bool result = true;
+    if (::write(fd, value.c_str(), value.size()) < 0) {
+        LOG_WARNING("Failed to write '" + value + "' to " + path + " - " + strerror(errno), LOG_NAME);
+        result = false;
+    }
+    close(fd);
+    return result;
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_FILE_H_
+#define UTIL_FILE_H_
+
+#include <iostream>
+
+using namespace std;
+
+class File {
+public:
+    static bool exists(const string& path);
+    static bool readLong(const string& path, long& value);
+    static bool readLongLong(const string& path, long long& value);
+    static bool readString(const string& path, string& value);
+    static bool write(const string& path, const string& value);
+
+    File() {}
+    virtual ~File() {}
+};
+
+#endif /* UTIL_FILE_H_ */
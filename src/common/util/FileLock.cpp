@@ -30,8 +30,8 @@ FileLock::FileLock(string path)
 {
     m_fd = open(path.c_str(), O_RDWR | O_CREAT);
     if (m_fd < 0) {
-        Logger::error("File open error - " + path, LOG_NAME);
-        Logger::error(strerror(errno), LOG_NAME);
+        LOG_ERROR("File open error - " + path, LOG_NAME);
+        LOG_ERROR(strerror(errno), LOG_NAME);
     }
 }
 
@@ -16,68 +16,82 @@
 
 #include "Logger.h"
 
+#include <algorithm>
+#include <stdio.h>
 #include <string.h>
 
-void Logger::verbose(string msg, string name)
+#define LOG_DRAIN_TIMEOUT 100
+
+void Logger::verbose(const string& msg, const string& name)
 {
     getInstance().write(msg, name, LogLevel_VERBOSE);
 }
 
-void Logger::debug(string msg, string name)
+void Logger::debug(const string& msg, const string& name)
 {
     getInstance().write(msg, name, LogLevel_DEBUG);
 }
 
-void Logger::normal(string msg, string name)
+void Logger::normal(const string& msg, const string& name)
 {
     getInstance().write(msg, name, LogLevel_NORMAL);
 }
 
-void Logger::warning(string msg, string name)
+void Logger::warning(const string& msg, const string& name)
 {
     getInstance().write(msg, name, LogLevel_WARNING);
 }
 
-void Logger::error(string msg, string name)
+void Logger::error(const string& msg, const string& name)
 {
     getInstance().write(msg, name, LogLevel_ERROR);
 }
 
-string& Logger::convertLevel(enum LogLevel& level)
+const char* Logger::convertLevel(enum LogLevel level)
 {
-    static string verbose = "VERBOSE";
-    static string debug = "DEBUG";
-    static string normal = "NORMAL";
-    static string warning = "WARNING";
-    static string error = "ERROR";
-
     switch(level) {
     case LogLevel_VERBOSE:
-        return verbose;
+        return "VERBOSE";
 
     case LogLevel_DEBUG:
-        return debug;
+        return "DEBUG";
 
     case LogLevel_NORMAL:
-        return normal;
+        return "NORMAL";
 
     case LogLevel_WARNING:
-        return warning;
+        return "WARNING";
 
     case LogLevel_ERROR:
-       return error;
+       return "ERROR";
     }
-    return debug;
+    return "DEBUG";
 }
 
 Logger::Logger()
     : m_level(LogLevel_VERBOSE)
     , m_type(LogType_CONSOLE)
+    , m_head(0)
+    , m_tail(0)
+    , m_dropped(0)
+    , m_truncated(0)
+    , m_isRunning(true)
 {
+    for (size_t i = 0; i < LOG_RING_SIZE; ++i) {
+        m_records[i].sequence.store(i, memory_order_relaxed);
+    }
+#ifdef USE_PMLOG
+    m_context = nullptr;
+#endif
+    m_writer = thread(&Logger::run, this);
 }
 
 Logger::~Logger()
 {
+    m_isRunning = false;
+    m_cond.notify_one();
+    if (m_writer.joinable())
+        m_writer.join();
 }
 
 void Logger::setLevel(enum LogLevel level)
@@ -87,39 +101,191 @@ void Logger::setLevel(enum LogLevel level)
 
 void Logger::setType(enum LogType type)
 {
+#ifdef USE_PMLOG
+    if (type == LogType_PMLOG && m_context == nullptr)
+        PmLogGetContext("memorymanager", &m_context);
+#endif
     m_type = type;
 }
 
-void Logger::write(string& msg, string& name, enum LogLevel level)
+void Logger::fillRecord(Record& record, const char* msg, size_t size, const string& name, enum LogLevel level)
+{
+    record.level = level;
+    strncpy(record.name, name.c_str(), LOG_NAME_SIZE - 1);
+    record.name[LOG_NAME_SIZE - 1] = '\0';
+    memcpy(record.msg, msg, size);
+    record.msg[size] = '\0';
+}
+
+void Logger::write(const string& msg, const string& name, enum LogLevel level)
 {
     if (level < m_level)
         return;
 
-    string log = "[" + convertLevel(level) + "][" + (name.empty() ? "UNKNOWN" : name)  + "] " + msg;
+    // Each record holds a part of the message
+    const size_t chunk = LOG_MSG_SIZE - 1;
+    size_t size = msg.size();
+    if (size > chunk * LOG_MSG_RECORDS) {
+        size = chunk * LOG_MSG_RECORDS;
+        m_truncated.fetch_add(1, memory_order_relaxed);
+    }
+
+    size_t offset = 0;
+    do {
+        size_t length = min(size - offset, chunk);
+        if (!m_isRunning) {
+            // The writer is already stopped
+            Record record;
+            fillRecord(record, msg.c_str() + offset, length, name, level);
+            writeRecord(record);
+        } else if (!push(msg.c_str() + offset, length, name, level)) {
+            m_dropped.fetch_add(1, memory_order_relaxed);
+            break;
+        }
+        offset += length;
+    } while (offset < size);
+
+    if (m_isRunning)
+        m_cond.notify_one();
+}
+
+bool Logger::push(const char* msg, size_t size, const string& name, enum LogLevel level)
+{
+    // Bounded MPMC queue. A slot is free for 'pos' if its sequence is 'pos'
+    // and is ready to be read if its sequence is 'pos + 1'.
+    size_t pos = m_head.load(memory_order_relaxed);
+    Record* record;
+    for (;;) {
+        record = &m_records[pos & (LOG_RING_SIZE - 1)];
+        size_t sequence = record->sequence.load(memory_order_acquire);
+        long diff = (long)sequence - (long)pos;
+        if (diff == 0) {
+            if (m_head.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            // full
+            return false;
+        } else {
+            pos = m_head.load(memory_order_relaxed);
+        }
+    }
+
+    fillRecord(*record, msg, size, name, level);
+    record->sequence.store(pos + 1, memory_order_release);
+    return true;
+}
+
+bool Logger::drain()
+{
+    bool drained = false;
+    for (;;) {
+        Record& record = m_records[m_tail & (LOG_RING_SIZE - 1)];
+        if (record.sequence.load(memory_order_acquire) != m_tail + 1)
+            break;
+
+        writeRecord(record);
+        record.sequence.store(m_tail + LOG_RING_SIZE, memory_order_release);
+        m_tail++;
+        drained = true;
+    }
+
+    unsigned long dropped = m_dropped.exchange(0, memory_order_relaxed);
+    if (dropped > 0) {
+        Record record;
+        record.level = LogLevel_WARNING;
+        strcpy(record.name, "Logger");
+        snprintf(record.msg, LOG_MSG_SIZE, "%lu logs are dropped", dropped);
+        writeRecord(record);
+    }
+
+    unsigned long truncated = m_truncated.exchange(0, memory_order_relaxed);
+    if (truncated > 0) {
+        Record record;
+        record.level = LogLevel_WARNING;
+        strcpy(record.name, "Logger");
+        snprintf(record.msg, LOG_MSG_SIZE, "%lu logs are truncated", truncated);
+        writeRecord(record);
+    }
+
+    if (drained && m_type == LogType_CONSOLE) {
+        fflush(stdout);
+        fflush(stderr);
+    }
+    return drained;
+}
+
+void Logger::run()
+{
+    while (m_isRunning) {
+        if (drain())
+            continue;
+        // A missed notification only delays the output until the timeout
+        unique_lock<mutex> lock(m_mutex);
+        m_cond.wait_for(lock, chrono::milliseconds(LOG_DRAIN_TIMEOUT));
+    }
+    drain();
+}
 
+void Logger::writeRecord(Record& record)
+{
     switch (m_type) {
     case LogType_CONSOLE:
-        writeConsole(log, level);
+        writeConsole(record);
+        break;
+
+    case LogType_PMLOG:
+        writePmLog(record);
         break;
 
     default:
-        cerr << "Unsupported Log Type" << endl;
+        fputs("Unsupported Log Type\n", stderr);
         break;
     }
 }
 
-void Logger::writeConsole(string& log, enum LogLevel& level)
+void Logger::writeConsole(Record& record)
 {
-    switch(level) {
+    const char* name = record.name[0] == '\0' ? "UNKNOWN" : record.name;
+
+    switch(record.level) {
+    case LogLevel_VERBOSE:
+    case LogLevel_DEBUG:
+    case LogLevel_NORMAL:
+        fprintf(stdout, "[%s][%s] %s\n", convertLevel(record.level), name, record.msg);
+        break;
+
+    case LogLevel_WARNING:
+    case LogLevel_ERROR:
+        fprintf(stderr, "[%s][%s] %s\n", convertLevel(record.level), name, record.msg);
+        break;
+    }
+}
+
+void Logger::writePmLog(Record& record)
+{
+#ifdef USE_PMLOG
+    const char* name = record.name[0] == '\0' ? "UNKNOWN" : record.name;
+
+    switch(record.level) {
     case LogLevel_VERBOSE:
     case LogLevel_DEBUG:
+        // PmLog does not allow msgid for debug logs
+        PmLogString(m_context, kPmLogLevel_Debug, nullptr, nullptr, (string("[") + name + "] " + record.msg).c_str());
+        break;
+
     case LogLevel_NORMAL:
-        cout << log << endl;
+        PmLogString(m_context, kPmLogLevel_Info, name, "{}", record.msg);
         break;
 
     case LogLevel_WARNING:
+        PmLogString(m_context, kPmLogLevel_Warning, name, "{}", record.msg);
+        break;
+
     case LogLevel_ERROR:
-        cerr << log << endl;
+        PmLogString(m_context, kPmLogLevel_Error, name, "{}", record.msg);
         break;
     }
+#else
+    writeConsole(record);
+#endif
 }
@@ -18,9 +18,32 @@
 #define UTIL_LOGGER_H_
 
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#ifdef USE_PMLOG
+#include <PmLogLib.h>
+#endif
 
 #include "Fifo.h"
 
+// Longer messages are split into several records, and are truncated
+// (and counted) beyond LOG_MSG_RECORDS records
+#define LOG_NAME_SIZE     32
+#define LOG_MSG_SIZE      480
+#define LOG_MSG_RECORDS   8
+// Must be a power of two
+#define LOG_RING_SIZE     1024
+
+// The message is only built if the level is enabled
+#define LOG_VERBOSE(...)  do { if (Logger::isEnabled(LogLevel_VERBOSE)) Logger::verbose(__VA_ARGS__); } while (0)
+#define LOG_DEBUG(...)    do { if (Logger::isEnabled(LogLevel_DEBUG)) Logger::debug(__VA_ARGS__); } while (0)
+#define LOG_NORMAL(...)   do { if (Logger::isEnabled(LogLevel_NORMAL)) Logger::normal(__VA_ARGS__); } while (0)
+#define LOG_WARNING(...)  do { if (Logger::isEnabled(LogLevel_WARNING)) Logger::warning(__VA_ARGS__); } while (0)
+#define LOG_ERROR(...)    do { if (Logger::isEnabled(LogLevel_ERROR)) Logger::error(__VA_ARGS__); } while (0)
+
 using namespace std;
 
 enum LogLevel {
@@ -36,13 +59,21 @@ enum LogType {
     LogType_PMLOG
 };
 
+// Callers only copy the record into a lock-free ring buffer. A writer
+// thread drains it to the console or PmLog, so a slow output never blocks
+// the caller. Records are dropped (and counted) if the buffer is full.
 class Logger {
 public:
-    static void verbose(string msg, string name = "");
-    static void debug(string msg, string name = "");
-    static void normal(string msg, string name = "");
-    static void warning(string msg, string name = "");
-    static void error(string msg, string name = "");
+    static void verbose(const string& msg, const string& name = "");
+    static void debug(const string& msg, const string& name = "");
+    static void normal(const string& msg, const string& name = "");
+    static void warning(const string& msg, const string& name = "");
+    static void error(const string& msg, const string& name = "");
+
+    static bool isEnabled(enum LogLevel level)
+    {
+        return level >= getInstance().m_level;
+    }
 
     static Logger& getInstance()
     {
@@ -56,15 +87,44 @@ public:
     void setType(enum LogType type);
 
 private:
-    static string& convertLevel(enum LogLevel& level);
+    struct Record {
+        atomic<size_t> sequence;
+        enum LogLevel level;
+        char name[LOG_NAME_SIZE];
+        char msg[LOG_MSG_SIZE];
+    };
+
+    static const char* convertLevel(enum LogLevel level);
+    static void fillRecord(Record& record, const char* msg, size_t size, const string& name, enum LogLevel level);
 
     Logger();
 
-    void write(string& msg, string& name, enum LogLevel level = LogLevel_DEBUG);
-    void writeConsole(string& log, enum LogLevel& level);
+    void write(const string& msg, const string& name, enum LogLevel level = LogLevel_DEBUG);
+    void writeRecord(Record& record);
+    void writeConsole(Record& record);
+    void writePmLog(Record& record);
+
+    bool push(const char* msg, size_t size, const string& name, enum LogLevel level);
+    bool drain();
+    void run();
 
     enum LogLevel m_level;
-    enum LogType m_type;
+    atomic<int> m_type;
+
+    Record m_records[LOG_RING_SIZE];
+    atomic<size_t> m_head;
+    size_t m_tail;
+    atomic<unsigned long> m_dropped;
+    atomic<unsigned long> m_truncated;
+
+    thread m_writer;
+    mutex m_mutex;
+    condition_variable m_cond;
+    atomic<bool> m_isRunning;
+
+#ifdef USE_PMLOG
+    PmLogContext m_context;
+#endif
 };
 
 #endif /* UTIL_LOGGER_H_ */
@@ -0,0 +1,119 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MemInfo.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Logger.h"
+#include "ProcFields.h"
+
+#define LOG_NAME "MemInfo"
+
+// Ordered as the kernel prints them, so lookups are mostly a single compare
+static const ProcField FIELDS[] = {
+    PROC_FIELD("MemTotal", MemInfoSnapshot, memTotal),
+    PROC_FIELD("MemFree", MemInfoSnapshot, memFree),
+    PROC_FIELD("MemAvailable", MemInfoSnapshot, memAvailable),
+    PROC_FIELD("Buffers", MemInfoSnapshot, buffers),
+    PROC_FIELD("Cached", MemInfoSnapshot, cached),
+    PROC_FIELD("SwapCached", MemInfoSnapshot, swapCached),
+    PROC_FIELD("Active", MemInfoSnapshot, active),
+    PROC_FIELD("Inactive", MemInfoSnapshot, inactive),
+    PROC_FIELD("Active(anon)", MemInfoSnapshot, activeAnon),
+    PROC_FIELD("Inactive(anon)", MemInfoSnapshot, inactiveAnon),
+    PROC_FIELD("Active(file)", MemInfoSnapshot, activeFile),
+    PROC_FIELD("Inactive(file)", MemInfoSnapshot, inactiveFile),
+    PROC_FIELD("Unevictable", MemInfoSnapshot, unevictable),
+    PROC_FIELD("Mlocked", MemInfoSnapshot, mlocked),
+    PROC_FIELD("SwapTotal", MemInfoSnapshot, swapTotal),
+    PROC_FIELD("SwapFree", MemInfoSnapshot, swapFree),
+    PROC_FIELD("Dirty", MemInfoSnapshot, dirty),
+    PROC_FIELD("Writeback", MemInfoSnapshot, writeback),
+    PROC_FIELD("AnonPages", MemInfoSnapshot, anonPages),
+    PROC_FIELD("Mapped", MemInfoSnapshot, mapped),
+    PROC_FIELD("Shmem", MemInfoSnapshot, shmem),
+    PROC_FIELD("KReclaimable", MemInfoSnapshot, kReclaimable),
+    PROC_FIELD("Slab", MemInfoSnapshot, slab),
+    PROC_FIELD("SReclaimable", MemInfoSnapshot, sReclaimable),
+    PROC_FIELD("SUnreclaim", MemInfoSnapshot, sUnreclaim),
+    PROC_FIELD("KernelStack", MemInfoSnapshot, kernelStack),
+    PROC_FIELD("PageTables", MemInfoSnapshot, pageTables),
+    PROC_FIELD("CommitLimit", MemInfoSnapshot, commitLimit),
+    PROC_FIELD("Committed_AS", MemInfoSnapshot, committedAs),
+    PROC_FIELD("VmallocUsed", MemInfoSnapshot, vmallocUsed),
+    PROC_FIELD("AnonHugePages", MemInfoSnapshot, anonHugePages),
+    PROC_FIELD("ShmemHugePages", MemInfoSnapshot, shmemHugePages),
+    PROC_FIELD("CmaTotal", MemInfoSnapshot, cmaTotal),
+    PROC_FIELD("CmaFree", MemInfoSnapshot, cmaFree),
+};
+
+static const size_t FIELD_COUNT = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+const char* MemInfoReader::PATH = "/proc/meminfo";
+
+bool MemInfoReader::parse(const char* buffer, size_t size, MemInfoSnapshot& snapshot)
+{
+    memset(&snapshot, -1, sizeof(snapshot));
+    ProcFields::parse(buffer, size, FIELDS, FIELD_COUNT, &snapshot);
+
+    if (snapshot.memTotal < 0)
+        return false;
+
+    // MemAvailable is provided since Linux 3.14
+    if (snapshot.memAvailable < 0) {
+        snapshot.memAvailable = snapshot.memFree;
+        if (snapshot.cached > 0)
+            snapshot.memAvailable += snapshot.cached;
+        if (snapshot.buffers > 0)
+            snapshot.memAvailable += snapshot.buffers;
+    }
+    return true;
+}
+
+MemInfoReader::MemInfoReader()
+    : m_fd(-1)
+{
+}
+
+MemInfoReader::~MemInfoReader()
+{
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool MemInfoReader::read(MemInfoSnapshot& snapshot)
+{
+    if (m_fd < 0) {
+        m_fd = open(PATH, O_RDONLY | O_CLOEXEC);
+        if (m_fd < 0) {
+            LOG_ERROR(string("Failed to open meminfo - ") + strerror(errno), LOG_NAME);
+            return false;
+        }
+    }
+
+    ssize_t size = pread(m_fd, m_buffer, BUFFER_SIZE, 0);
+    if (size <= 0) {
+        LOG_ERROR(string("Failed to read meminfo - ") + strerror(errno), LOG_NAME);
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    return parse(m_buffer, size, snapshot);
+}
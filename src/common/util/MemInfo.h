@@ -0,0 +1,80 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_MEMINFO_H_
+#define UTIL_MEMINFO_H_
+
+#include <stddef.h>
+
+// All values are KB as reported by '/proc/meminfo'.
+// Fields which are not provided by the kernel remain -1.
+struct MemInfoSnapshot {
+    long memTotal;
+    long memFree;
+    long memAvailable;
+    long buffers;
+    long cached;
+    long swapCached;
+    long active;
+    long inactive;
+    long activeAnon;
+    long inactiveAnon;
+    long activeFile;
+    long inactiveFile;
+    long unevictable;
+    long mlocked;
+    long swapTotal;
+    long swapFree;
+    long dirty;
+    long writeback;
+    long anonPages;
+    long mapped;
+    long shmem;
+    long kReclaimable;
+    long slab;
+    long sReclaimable;
+    long sUnreclaim;
+    long kernelStack;
+    long pageTables;
+    long commitLimit;
+    long committedAs;
+    long vmallocUsed;
+    long anonHugePages;
+    long shmemHugePages;
+    long cmaTotal;
+    long cmaFree;
+};
+
+class MemInfoReader {
+public:
+    static const char* PATH;
+
+    // Parses the content of '/proc/meminfo'. Returns false if MemTotal is missing.
+    static bool parse(const char* buffer, size_t size, MemInfoSnapshot& snapshot);
+
+    MemInfoReader();
+    virtual ~MemInfoReader();
+
+    bool read(MemInfoSnapshot& snapshot);
+
+private:
+    static const size_t BUFFER_SIZE = 8192;
+
+    int m_fd;
+    char m_buffer[BUFFER_SIZE];
+};
+
+#endif /* UTIL_MEMINFO_H_ */
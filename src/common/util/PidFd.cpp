@@ -0,0 +1,55 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PidFd.h"
+
+#include <signal.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// The numbers are same on all architectures since Linux 5.1
+#ifndef __NR_pidfd_send_signal
+#define __NR_pidfd_send_signal 424
+#endif
+#ifndef __NR_pidfd_open
+#define __NR_pidfd_open 434
+#endif
+#ifndef __NR_process_madvise
+#define __NR_process_madvise 440
+#endif
+#ifndef __NR_process_mrelease
+#define __NR_process_mrelease 448
+#endif
+
+int PidFd::open(pid_t pid)
+{
+    return syscall(__NR_pidfd_open, pid, 0);
+}
+
+int PidFd::sendSignal(int pidfd, int signal)
+{
+    return syscall(__NR_pidfd_send_signal, pidfd, signal, NULL, 0);
+}
+
+int PidFd::mrelease(int pidfd)
+{
+    return syscall(__NR_process_mrelease, pidfd, 0);
+}
+
+ssize_t PidFd::madvise(int pidfd, const struct iovec* iov, size_t count, int advice)
+{
+    return syscall(__NR_process_madvise, pidfd, iov, count, advice, 0);
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_PIDFD_H_
+#define UTIL_PIDFD_H_
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+// Thin wrappers of pidfd system calls. All of them fail with ENOSYS
+// on kernels which do not provide them.
+class PidFd {
+public:
+    // Linux 5.3
+    static int open(pid_t pid);
+    // Linux 5.1
+    static int sendSignal(int pidfd, int signal);
+    // Linux 5.15. Reaps the address space of a dying process.
+    static int mrelease(int pidfd);
+    // Linux 5.10. Returns advised bytes. 'count' is limited to IOV_MAX.
+    static ssize_t madvise(int pidfd, const struct iovec* iov, size_t count, int advice);
+
+    PidFd() {}
+    virtual ~PidFd() {}
+};
+
+#endif /* UTIL_PIDFD_H_ */
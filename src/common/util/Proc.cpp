@@ -16,24 +16,343 @@
 
 #include "Proc.h"
 
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "File.h"
+#include "ProcFields.h"
+
+static const ProcField SMAPS_FIELDS[] = {
+    PROC_FIELD("Rss", SmapsRollupSnapshot, rss),
+    PROC_FIELD("Pss", SmapsRollupSnapshot, pss),
+    PROC_FIELD("Shared_Clean", SmapsRollupSnapshot, sharedClean),
+    PROC_FIELD("Shared_Dirty", SmapsRollupSnapshot, sharedDirty),
+    PROC_FIELD("Private_Clean", SmapsRollupSnapshot, privateClean),
+    PROC_FIELD("Private_Dirty", SmapsRollupSnapshot, privateDirty),
+    PROC_FIELD("Swap", SmapsRollupSnapshot, swap),
+    PROC_FIELD("SwapPss", SmapsRollupSnapshot, swapPss),
+};
+
+static const size_t SMAPS_FIELD_COUNT = sizeof(SMAPS_FIELDS) / sizeof(SMAPS_FIELDS[0]);
+
+static MemInfoReader s_memInfoReader;
+static const MemInfoSnapshot* s_memInfoSource = nullptr;
+
+void Proc::setMemoryInfoSource(const MemInfoSnapshot* snapshot)
+{
+    s_memInfoSource = snapshot;
+}
+
 bool Proc::getMemoryInfo(long& total, long& available)
 {
-    string type;
+    MemInfoSnapshot snapshot;
+    if (!getMemoryInfo(snapshot))
+        return false;
+
+    total = snapshot.memTotal / 1024;
+    available = snapshot.memAvailable / 1024;
+    return true;
+}
+
+bool Proc::getMemoryInfo(MemInfoSnapshot& snapshot)
+{
+    if (s_memInfoSource) {
+        snapshot = *s_memInfoSource;
+        return (snapshot.memTotal > 0);
+    }
+    return s_memInfoReader.read(snapshot);
+}
+
+bool Proc::getSmapsRollup(int pid, SmapsRollupSnapshot& snapshot)
+{
+    static char buffer[4096];
+    char path[64];
+
+    memset(&snapshot, -1, sizeof(snapshot));
+
+    snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", pid);
+    ssize_t size = ProcFields::read(path, buffer, sizeof(buffer));
+    if (size > 0) {
+        ProcFields::parse(buffer, size, SMAPS_FIELDS, SMAPS_FIELD_COUNT, &snapshot);
+        return (snapshot.pss >= 0);
+    }
+
+    // smaps_rollup is provided since Linux 4.14
+    snprintf(path, sizeof(path), "/proc/%d/smaps", pid);
+    FILE* fp = fopen(path, "r");
+    if (fp == NULL)
+        return false;
+
+    while ((size = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        // keep a partial line for the next chunk
+        ssize_t last = size;
+        while (last > 0 && buffer[last - 1] != '\n')
+            --last;
+        if (last == 0)
+            break;
+        ProcFields::parse(buffer, last, SMAPS_FIELDS, SMAPS_FIELD_COUNT, &snapshot, true);
+        fseek(fp, last - size, SEEK_CUR);
+    }
+    fclose(fp);
+    return (snapshot.pss >= 0);
+}
+
+bool Proc::getMinFree(long& minFree)
+{
+    if (s_memInfoSource) {
+        // Estimated from the simulated memory as the kernel does
+        // (sqrt(lowmem_kbytes * 16) within [128, 262144])
+        if (s_memInfoSource->memTotal <= 0)
+            return false;
+        minFree = (long)sqrt((double)s_memInfoSource->memTotal * 16);
+        minFree = min(max(minFree, 128L), 262144L);
+        return true;
+    }
+    return File::readLong("/proc/sys/vm/min_free_kbytes", minFree);
+}
+
+bool Proc::getZoneInfo(ZoneInfoSnapshot& snapshot)
+{
+    // Zones of the host are not the simulated memory
+    if (s_memInfoSource)
+        return false;
+
+    FILE* fp = fopen("/proc/zoneinfo", "r");
+    if (fp == NULL)
+        return false;
+
+    // Values are pages. Per-CPU pagesets are skipped by the key.
+    long pageSize = sysconf(_SC_PAGESIZE) / 1024;
+    char line[256];
+    char key[32];
     long value;
-    string kb;
 
-    ifstream meminfo("/proc/meminfo");
-    while (true) {
-        meminfo >> type >> value >> kb;
+    memset(&snapshot, 0, sizeof(snapshot));
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (sscanf(line, "%31s %ld", key, &value) != 2)
+            continue;
 
-        if (type == "MemTotal:") {
-            total = value / 1024;
-        }
-        if (type == "MemAvailable:") {
-            available = value / 1024;
+        if (strcmp(key, "min") == 0)
+            snapshot.min += value * pageSize;
+        else if (strcmp(key, "low") == 0)
+            snapshot.low += value * pageSize;
+        else if (strcmp(key, "high") == 0)
+            snapshot.high += value * pageSize;
+        else if (strcmp(key, "managed") == 0)
+            snapshot.managed += value * pageSize;
+    }
+    fclose(fp);
+    return (snapshot.managed > 0);
+}
+
+bool Proc::getZramInfo(const string& device, ZramSnapshot& snapshot)
+{
+    // Simulated memory has no zram device
+    if (s_memInfoSource)
+        return false;
+
+    string path = "/sys/block/" + device;
+    char buffer[256];
+
+    // Bytes. They can be larger than 'long' on 32bit systems.
+    ssize_t size = ProcFields::read((path + "/mm_stat").c_str(), buffer, sizeof(buffer) - 1);
+    if (size <= 0)
+        return false;
+    buffer[size] = '\0';
+
+    long long values[5];
+    if (sscanf(buffer, "%lld %lld %lld %lld %lld",
+               &values[0], &values[1], &values[2], &values[3], &values[4]) != 5)
+        return false;
+    snapshot.origDataSize = (long)(values[0] / 1024);
+    snapshot.comprDataSize = (long)(values[1] / 1024);
+    snapshot.memUsedTotal = (long)(values[2] / 1024);
+    snapshot.memLimit = (long)(values[3] / 1024);
+    snapshot.memUsedMax = (long)(values[4] / 1024);
+
+    snapshot.diskSize = 0;
+    size = ProcFields::read((path + "/disksize").c_str(), buffer, sizeof(buffer) - 1);
+    if (size > 0) {
+        buffer[size] = '\0';
+        snapshot.diskSize = (long)(strtoll(buffer, NULL, 10) / 1024);
+    }
+    return true;
+}
+
+static bool readPids(const char* path, vector<int>& pids)
+{
+    char buffer[4096];
+    ssize_t size = ProcFields::read(path, buffer, sizeof(buffer) - 1);
+    if (size < 0)
+        return false;
+    buffer[size] = '\0';
+
+    char* pos = buffer;
+    char* end;
+    while (true) {
+        long pid = strtol(pos, &end, 10);
+        if (end == pos)
             break;
+        pids.push_back((int)pid);
+        pos = end;
+    }
+    return true;
+}
+
+bool Proc::getChildren(int pid, vector<int>& children)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/task", pid);
+
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+        // The process is gone
+        return true;
+    }
+
+    bool supported = true;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            continue;
+        snprintf(path, sizeof(path), "/proc/%d/task/%s/children", pid, entry->d_name);
+        if (!readPids(path, children) && errno == ENOENT) {
+            // The thread may be gone. Check whether the file is supported at all.
+            snprintf(path, sizeof(path), "/proc/%d/task/%d/children", pid, pid);
+            if (access(path, F_OK) != 0) {
+                supported = false;
+                break;
+            }
         }
     }
-    meminfo.close();
+    closedir(dir);
+    return supported;
+}
+
+bool Proc::getParent(int pid, int& ppid)
+{
+    char path[64];
+    char buffer[512];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    ssize_t size = ProcFields::read(path, buffer, sizeof(buffer) - 1);
+    if (size <= 0)
+        return false;
+    buffer[size] = '\0';
+
+    // 'pid (comm) state ppid ...' where comm may contain spaces
+    char* pos = strrchr(buffer, ')');
+    if (pos == NULL)
+        return false;
+    return (sscanf(pos + 1, " %*c %d", &ppid) == 1);
+}
+
+bool Proc::getStartTime(int pid, unsigned long long& startTime)
+{
+    char path[64];
+    char buffer[512];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    ssize_t size = ProcFields::read(path, buffer, sizeof(buffer) - 1);
+    if (size <= 0)
+        return false;
+    buffer[size] = '\0';
+
+    // 'starttime' is the 22nd field and 'state' is the 3rd one
+    char* pos = strrchr(buffer, ')');
+    if (pos == NULL)
+        return false;
+    return (sscanf(pos + 1, " %*c %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %llu",
+                   &startTime) == 1);
+}
+
+bool Proc::getParents(map<int, int>& parents)
+{
+    DIR* dir = opendir("/proc");
+    if (dir == NULL)
+        return false;
+
+    char path[64];
+    char buffer[512];
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9')
+            continue;
+        snprintf(path, sizeof(path), "/proc/%s/stat", entry->d_name);
+        ssize_t size = ProcFields::read(path, buffer, sizeof(buffer) - 1);
+        if (size <= 0)
+            continue;
+        buffer[size] = '\0';
+
+        // 'pid (comm) state ppid ...' where comm may contain spaces
+        char* pos = strrchr(buffer, ')');
+        if (pos == NULL)
+            continue;
+        int ppid;
+        if (sscanf(pos + 1, " %*c %d", &ppid) != 1)
+            continue;
+        parents[atoi(entry->d_name)] = ppid;
+    }
+    closedir(dir);
+    return true;
+}
+
+bool Proc::getCgroupProcs(const string& cgroup, vector<int>& pids)
+{
+    string path = cgroup + "/cgroup.procs";
+    return readPids(path.c_str(), pids);
+}
+
+bool Proc::getAnonymousRegions(int pid, vector<MemoryRegion>& regions)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/maps", pid);
+    ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    // 'start-end perms offset dev inode name'
+    regions.clear();
+    string line;
+    while (getline(file, line)) {
+        MemoryRegion region;
+        char perms[5];
+        unsigned long inode;
+        int name = 0;
+        if (sscanf(line.c_str(), "%lx-%lx %4s %*x %*x:%*x %lu %n",
+                   &region.start, &region.end, perms, &inode, &name) < 4)
+            continue;
+        if (inode != 0 || perms[1] != 'w' || perms[3] != 'p')
+            continue;
+        if (name > 0 && line[name] != '\0' &&
+            line.compare(name, string::npos, "[heap]") != 0 &&
+            line.compare(name, 6, "[anon:") != 0)
+            continue;
+        regions.push_back(region);
+    }
+    return true;
+}
+
+bool Proc::getCgroup(int pid, string& cgroup)
+{
+    char path[64];
+    char buffer[1024];
+    snprintf(path, sizeof(path), "/proc/%d/cgroup", pid);
+    ssize_t size = ProcFields::read(path, buffer, sizeof(buffer) - 1);
+    if (size <= 0)
+        return false;
+    buffer[size] = '\0';
+
+    // The unified hierarchy is '0::<path>'
+    char* line = strstr(buffer, "0::");
+    if (line == NULL || (line != buffer && line[-1] != '\n'))
+        return false;
+    line += 3;
+    char* end = strchr(line, '\n');
+    cgroup.assign(line, end ? end - line : strlen(line));
     return true;
 }
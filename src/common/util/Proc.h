@@ -19,9 +19,49 @@
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <vector>
+
+#include "MemInfo.h"
 
 using namespace std;
 
+// All values are KB. Fields which are not provided remain -1.
+struct SmapsRollupSnapshot {
+    long rss;
+    long pss;
+    long sharedClean;
+    long sharedDirty;
+    long privateClean;
+    long privateDirty;
+    long swap;
+    long swapPss;
+};
+
+// Sum of all zones in '/proc/zoneinfo' (KB)
+struct ZoneInfoSnapshot {
+    long min;
+    long low;
+    long high;
+    long managed;
+};
+
+// '/sys/block/<zram>/disksize' and 'mm_stat' (KB). 'memLimit' is 0 if not limited.
+struct ZramSnapshot {
+    long diskSize;
+    long origDataSize;
+    long comprDataSize;
+    long memUsedTotal;
+    long memLimit;
+    long memUsedMax;
+};
+
+// A virtual address range [start, end)
+struct MemoryRegion {
+    unsigned long start;
+    unsigned long end;
+};
+
 enum OverCommitPolicy {
     OverCommitPolicy_Default
 
@@ -32,7 +72,47 @@ public:
     Proc() {}
     virtual ~Proc() {}
 
+    // Snapshots are copied from 'snapshot' instead of '/proc/meminfo' while
+    // it is set (memorymanager-sim). nullptr restores the file.
+    static void setMemoryInfoSource(const MemInfoSnapshot* snapshot);
+
+    // MB
     static bool getMemoryInfo(long& total, long& available);
+    static bool getMemoryInfo(MemInfoSnapshot& snapshot);
+
+    // '/proc/sys/vm/min_free_kbytes' (KB)
+    static bool getMinFree(long& minFree);
+
+    // Watermarks of all zones
+    static bool getZoneInfo(ZoneInfoSnapshot& snapshot);
+
+    // Reads the statistics of the zram device (e.g. 'zram0')
+    static bool getZramInfo(const string& device, ZramSnapshot& snapshot);
+
+    // Reads '/proc/<pid>/smaps_rollup' or sums '/proc/<pid>/smaps' on old kernels
+    static bool getSmapsRollup(int pid, SmapsRollupSnapshot& snapshot);
+
+    // Writable private mappings which are not backed by files ('[heap]' included)
+    static bool getAnonymousRegions(int pid, vector<MemoryRegion>& regions);
+
+    // Direct children of all threads of 'pid'. Returns false if
+    // '/proc/<pid>/task/<tid>/children' is not supported (CONFIG_PROC_CHILDREN)
+    static bool getChildren(int pid, vector<int>& children);
+
+    static bool getParent(int pid, int& ppid);
+
+    // Clock ticks since boot when the process started. A reused pid has
+    // a different one.
+    static bool getStartTime(int pid, unsigned long long& startTime);
+
+    // pid => ppid of all processes (slow path of 'getChildren')
+    static bool getParents(map<int, int>& parents);
+
+    // cgroup v2 path of the process relative to the mount point
+    static bool getCgroup(int pid, string& cgroup);
+
+    // pids listed in 'cgroup.procs' of the given cgroup directory
+    static bool getCgroupProcs(const string& cgroup, vector<int>& pids);
 };
 
 #endif /* UTIL_PROC_H_ */
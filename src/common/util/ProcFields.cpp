@@ -0,0 +1,97 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ProcFields.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+void ProcFields::parse(const char* buffer, size_t size,
+                       const ProcField* fields, size_t count,
+                       void* out, bool accumulate, char separator)
+{
+    const char* pos = buffer;
+    const char* end = buffer + size;
+    size_t hint = 0;
+
+    while (pos < end) {
+        const char* eol = (const char*)memchr(pos, '\n', end - pos);
+        if (eol == nullptr)
+            eol = end;
+
+        const char* colon = (const char*)memchr(pos, separator, eol - pos);
+        if (colon == nullptr) {
+            pos = eol + 1;
+            continue;
+        }
+        size_t length = colon - pos;
+
+        const ProcField* field = nullptr;
+        for (size_t i = hint; i < count + hint; ++i) {
+            const ProcField& candidate = fields[i < count ? i : i - count];
+            if (candidate.length == length && memcmp(candidate.name, pos, length) == 0) {
+                field = &candidate;
+                hint = (&candidate - fields) + 1;
+                break;
+            }
+        }
+
+        if (field != nullptr) {
+            pos = colon + 1;
+            while (pos < eol && *pos == ' ')
+                ++pos;
+
+            long long value = 0;
+            while (pos < eol && *pos >= '0' && *pos <= '9') {
+                value = value * 10 + (*pos - '0');
+                ++pos;
+            }
+
+            if (field->size == sizeof(long long)) {
+                long long* dest = (long long*)((char*)out + field->offset);
+                if (accumulate && *dest > 0)
+                    *dest += value;
+                else
+                    *dest = value;
+            } else {
+                long* dest = (long*)((char*)out + field->offset);
+                if (accumulate && *dest > 0)
+                    *dest += value;
+                else
+                    *dest = value;
+            }
+        }
+        pos = eol + 1;
+    }
+}
+
+ssize_t ProcFields::read(const char* path, char* buffer, size_t size)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+    ssize_t total = 0;
+    while ((size_t)total < size) {
+        ssize_t n = pread(fd, buffer + total, size - total, total);
+        if (n <= 0)
+            break;
+        total += n;
+    }
+    close(fd);
+    return total;
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef UTIL_PROCFIELDS_H_
+#define UTIL_PROCFIELDS_H_
+
+#include <stddef.h>
+#include <sys/types.h>
+
+// Describes a 'Key: value' line of a proc file (or 'key value' of cgroup
+// files) and where its value is stored in the destination struct.
+// Values must be 'long' or 'long long' (e.g. bytes on 32bit systems).
+struct ProcField {
+    const char* name;
+    size_t length;
+    size_t offset;
+    size_t size;
+};
+
+#define PROC_FIELD(name, type, member) \
+    { name, sizeof(name) - 1, offsetof(type, member), sizeof(((type*)0)->member) }
+
+class ProcFields {
+public:
+    // Parses 'Key: value' lines into 'out'. Unknown keys are ignored.
+    // Fields are expected to be ordered as the kernel prints them.
+    // If 'accumulate' is true, repeated keys are summed (e.g. smaps).
+    static void parse(const char* buffer, size_t size,
+                      const ProcField* fields, size_t count,
+                      void* out, bool accumulate = false, char separator = ':');
+
+    // Reads a whole file with a single pread() into 'buffer'
+    static ssize_t read(const char* path, char* buffer, size_t size);
+};
+
+#endif /* UTIL_PROCFIELDS_H_ */
@@ -18,8 +18,18 @@
 
 #include <time.h>
 
+static Clock* s_clock = nullptr;
+
+void Time::setClock(Clock* clock)
+{
+    s_clock = clock;
+}
+
 long Time::getSystemTime()
 {
+    if (s_clock)
+        return (long)(s_clock->now() / 1000);
+
     struct timespec ts;
     if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1) {
         return 0;
@@ -27,6 +37,18 @@ long Time::getSystemTime()
     return ts.tv_sec;
 }
 
+long long Time::getSystemTimeInMs()
+{
+    if (s_clock)
+        return s_clock->now();
+
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1) {
+        return 0;
+    }
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
 Time::Time()
 {
 }
@@ -17,9 +17,23 @@
 #ifndef UTIL_TIME_H_
 #define UTIL_TIME_H_
 
+// Source of the monotonic time. Replaced by a virtual clock in memorymanager-sim.
+class Clock {
+public:
+    Clock() {}
+    virtual ~Clock() {}
+
+    // Milliseconds
+    virtual long long now() = 0;
+};
+
 class Time {
 public:
+    // nullptr restores the system clock
+    static void setClock(Clock* clock);
+
     static long getSystemTime();
+    static long long getSystemTimeInMs();
 
     Time();
     virtual ~Time();
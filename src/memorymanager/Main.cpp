@@ -23,10 +23,11 @@ using namespace std;
 
 int main(int argc, char** argv)
 {
-    Logger::verbose("start main program", LOG_NAME);
+    Logger::getInstance().setType(LogType_PMLOG);
+    LOG_VERBOSE("start main program", LOG_NAME);
     MemoryManager::getInstance().initialize();
     MemoryManager::getInstance().run();
-    Logger::verbose("end main program", LOG_NAME);
+    LOG_VERBOSE("end main program", LOG_NAME);
     return 1;
 }
 
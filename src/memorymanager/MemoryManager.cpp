@@ -16,13 +16,21 @@
 
 #include "MemoryManager.h"
 
+#include "cgroup/CgroupManager.h"
 #include "luna/client/ApplicationManager.h"
+#include "profile/ProfileManager.h"
+#include "reclaim/ReclaimManager.h"
+#include "trim/TrimManager.h"
 #include "util/Logger.h"
 
 #define LOG_NAME "MemoryManager"
 
 MemoryManager::MemoryManager()
-    : m_tickSrc(-1)
+    : m_tickSrc(0)
+    , m_tickInterval(0)
+    , m_sampleSrc(0)
+    , m_nextRequestId(0)
+    , m_reclaimSrc(0)
 {
     m_mainloop = g_main_loop_new(NULL, FALSE);
 }
@@ -37,50 +45,97 @@ void MemoryManager::initialize()
     SettingManager::getInstance().initialize(m_mainloop);
     LunaManager::getInstace().initialize(m_mainloop);
     MemoryInfoManager::getInstance().initialize(m_mainloop);
+    CgroupManager::getInstance().initialize(m_mainloop);
+    KillTracker::getInstance().initialize(m_mainloop);
+    ProfileManager::getInstance().initialize(m_mainloop);
+    TrimManager::getInstance().initialize(m_mainloop);
+    ReclaimManager::getInstance().initialize(m_mainloop);
+    FreezeManager::getInstance().initialize(m_mainloop);
+    PreloadManager::getInstance().initialize(m_mainloop);
+    m_policy.initialize(m_mainloop);
 
     SettingManager::getInstance().setListener(this);
     LunaManager::getInstace().setListener(this);
     MemoryInfoManager::getInstance().setListener(this);
     ApplicationManager::getInstance().setListener(this);
+    KillTracker::getInstance().setListener(this);
+    m_policy.setListener(this);
 }
 
 void MemoryManager::run()
 {
-    m_tickSrc = g_timeout_add_seconds(1, tick, this);
+    updateTick();
+    m_sampleSrc = g_timeout_add_seconds(SettingManager::getInstance().getSampleInterval(), _sample, this);
     g_main_loop_run(m_mainloop);
 }
 
+void MemoryManager::onSettingChanged()
+{
+    if (m_sampleSrc > 0) {
+        g_source_remove(m_sampleSrc);
+        m_sampleSrc = g_timeout_add_seconds(SettingManager::getInstance().getSampleInterval(), _sample, this);
+    }
+    // The level can be changed with new thresholds
+    MemoryInfoManager::getInstance().reload();
+    updateTick();
+    LunaManager::getInstace().postMemoryStatus();
+}
+
+void MemoryManager::updateTick()
+{
+    // PSI reports pressure as soon as it happens. The tick is still needed
+    // to detect level exits and to keep reclaiming while not NORMAL.
+    // The forecast needs regular samples even while NORMAL
+    int interval = SettingManager::getInstance().getTickInterval();
+    if (MemoryInfoManager::getInstance().isEventDriven() &&
+        !SettingManager::getInstance().isForecastEnabled() &&
+        MemoryInfoManager::getInstance().getCurrentLevel() == MemoryLevel_NORMAL) {
+        interval = SettingManager::getInstance().getPsiTickInterval();
+    }
+
+    if (m_tickSrc > 0 && m_tickInterval == interval)
+        return;
+
+    if (m_tickSrc > 0)
+        g_source_remove(m_tickSrc);
+    m_tickInterval = interval;
+    m_tickSrc = g_timeout_add_seconds(m_tickInterval, tick, this);
+}
+
 void MemoryManager::onTick()
 {
     MemoryInfoManager::getInstance().update(false);
 }
 
-bool MemoryManager::onRequireMemory(int requiredMemory, string& errorText)
+void MemoryManager::onRequireMemory(Message& request, int requiredMemory)
 {
-    for (int i = 0; i < SettingManager::getInstance().getRetryCount(); ++i) {
-        if (ApplicationManager::getInstance().getRunningAppCount() == 0) {
-            errorText = "Failed to reclaim required memory. All apps were closed";
-            return false;
-        }
+    unsigned long id = m_nextRequestId++;
+    m_requests[id] = request;
+    m_policy.requireMemory(id, requiredMemory);
 
-        if (MemoryInfoManager::getInstance().getExpectedLevel(requiredMemory) != MemoryLevel_CRITICAL) {
-            return true;
-        }
+    if (m_policy.hasRequests() && m_reclaimSrc == 0) {
+        m_reclaimSrc = g_timeout_add(SettingManager::getInstance().getRequireMemoryInterval(), _reclaim, this);
+    }
+}
 
-        ApplicationManager::getInstance().closeApp(true);
+void MemoryManager::reclaim()
+{
+    m_policy.reclaim();
 
-        // TODO: Need to update. Waiting is not good solution
-        sleep(1);
-        MemoryInfoManager::getInstance().update();
+    if (!m_policy.hasRequests() && m_reclaimSrc > 0) {
+        g_source_remove(m_reclaimSrc);
+        m_reclaimSrc = 0;
     }
-    errorText = "Failed to reclaim required memory. Timeout.";
-    return false;
 }
 
 bool MemoryManager::onMemoryStatus(JValue& responsePayload)
 {
     MemoryInfoManager::getInstance().print(responsePayload);
     ApplicationManager::getInstance().print(responsePayload);
+    TrimManager::getInstance().print(responsePayload);
+    ReclaimManager::getInstance().print(responsePayload);
+    FreezeManager::getInstance().print(responsePayload);
+    PreloadManager::getInstance().print(responsePayload);
     return true;
 }
 
@@ -91,20 +146,28 @@ bool MemoryManager::onManagerStatus(JValue& responsePayload)
 
 void MemoryManager::onEnter(enum MemoryLevel prev, enum MemoryLevel cur)
 {
+    updateTick();
+    ApplicationManager::getInstance().updateMemory();
+    ApplicationManager::getInstance().applyCgroups(cur);
     LunaManager::getInstace().postMemoryStatus();
     LunaManager::getInstace().signalLevelChanged(MemoryInfoManager::toString(prev), MemoryInfoManager::toString(cur));
 
     switch (cur) {
     case MemoryLevel_NORMAL:
-        Logger::normal("MemoryLevel - NORMAL", LOG_NAME);
+        LOG_NORMAL("MemoryLevel - NORMAL", LOG_NAME);
+        TrimManager::getInstance().reset();
         break;
 
     case MemoryLevel_LOW:
-        Logger::normal("MemoryLevel - LOW", LOG_NAME);
+        LOG_NORMAL("MemoryLevel - LOW", LOG_NAME);
+        if (SettingManager::getInstance().isFreezerOnLow())
+            FreezeManager::getInstance().freezeAll();
         break;
 
     case MemoryLevel_CRITICAL:
-        Logger::normal("MemoryLevel - CRITICAL", LOG_NAME);
+        LOG_NORMAL("MemoryLevel - CRITICAL", LOG_NAME);
+        if (SettingManager::getInstance().isFreezerOnLow())
+            FreezeManager::getInstance().freezeAll();
         break;
     }
 
@@ -112,15 +175,71 @@ void MemoryManager::onEnter(enum MemoryLevel prev, enum MemoryLevel cur)
 
 void MemoryManager::onLow()
 {
-    ApplicationManager::getInstance().closeApp(false);
+    m_policy.onLow();
 }
 
 void MemoryManager::onCritical()
 {
-    ApplicationManager::getInstance().closeApp(true);
+    m_policy.onCritical();
 }
 
 void MemoryManager::onApplicationsChanged()
 {
     LunaManager::getInstace().postMemoryStatus();
 }
+
+void MemoryManager::onKilled(const string& appId)
+{
+    // Memory is released now. Do not wait for the next tick
+    if (m_policy.hasRequests())
+        reclaim();
+    else
+        MemoryInfoManager::getInstance().update(false);
+}
+
+bool MemoryManager::onEvictPreloads()
+{
+    return PreloadManager::getInstance().evict();
+}
+
+bool MemoryManager::onReclaimSwap()
+{
+    return (ReclaimManager::getInstance().reclaim() > 0);
+}
+
+bool MemoryManager::onTrim(enum MemoryLevel level)
+{
+    return TrimManager::getInstance().trim(level);
+}
+
+bool MemoryManager::onCloseApp(bool includeForeground, int requiredMemory)
+{
+    return ApplicationManager::getInstance().closeApp(includeForeground, requiredMemory);
+}
+
+void MemoryManager::onUpdateMemory()
+{
+    ApplicationManager::getInstance().updateMemory();
+}
+
+int MemoryManager::getRunningAppCount()
+{
+    return ApplicationManager::getInstance().getRunningAppCount();
+}
+
+void MemoryManager::onRequireMemoryProgress(unsigned long id, int requiredMemory, int reclaimed)
+{
+    auto it = m_requests.find(id);
+    if (it == m_requests.end())
+        return;
+    LunaManager::getInstace().postRequireMemoryProgress(it->second, requiredMemory, reclaimed);
+}
+
+void MemoryManager::onRequireMemoryReply(unsigned long id, bool returnValue, const string& errorText, int reclaimed)
+{
+    auto it = m_requests.find(id);
+    if (it == m_requests.end())
+        return;
+    LunaManager::getInstace().replyRequireMemory(it->second, returnValue, errorText, reclaimed);
+    m_requests.erase(it);
+}
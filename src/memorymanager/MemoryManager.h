@@ -18,11 +18,16 @@
 #define MEMORYMANAGER_H_
 
 #include <iostream>
+#include <map>
 #include <glib.h>
 
+#include "freezer/FreezeManager.h"
+#include "kill/KillTracker.h"
 #include "luna/LunaManager.h"
 #include "luna/client/ApplicationManager.h"
 #include "memoryinfo/MemoryInfoManager.h"
+#include "policy/MemoryPolicy.h"
+#include "preload/PreloadManager.h"
 #include "setting/SettingManager.h"
 
 using namespace std;
@@ -30,7 +35,9 @@ using namespace std;
 class MemoryManager : public SettingManagerListener,
                       public LunaManagerListener,
                       public MemoryInfoManagerListener,
-                      public ApplicationManagerListener {
+                      public ApplicationManagerListener,
+                      public KillTrackerListener,
+                      public MemoryPolicyListener {
 public:
     static MemoryManager& getInstance()
     {
@@ -46,8 +53,11 @@ public:
     // MemoryManager
     virtual void onTick();
 
+    // SettingManagerListener
+    virtual void onSettingChanged();
+
     // LunaManagerListener
-    virtual bool onRequireMemory(int requiredMemory, string& errorText);
+    virtual void onRequireMemory(Message& request, int requiredMemory);
     virtual bool onManagerStatus(JValue& responsePayload);
     virtual bool onMemoryStatus(JValue& responsePayload);
 
@@ -59,6 +69,19 @@ public:
     // ApplicationManagerListener
     virtual void onApplicationsChanged();
 
+    // KillTrackerListener
+    virtual void onKilled(const string& appId);
+
+    // MemoryPolicyListener
+    virtual bool onEvictPreloads();
+    virtual bool onReclaimSwap();
+    virtual bool onTrim(enum MemoryLevel level);
+    virtual bool onCloseApp(bool includeForeground, int requiredMemory);
+    virtual void onUpdateMemory();
+    virtual int getRunningAppCount();
+    virtual void onRequireMemoryProgress(unsigned long id, int requiredMemory, int reclaimed);
+    virtual void onRequireMemoryReply(unsigned long id, bool returnValue, const string& errorText, int reclaimed);
+
 private:
     static gboolean tick(gpointer user_data)
     {
@@ -66,10 +89,37 @@ private:
         return G_SOURCE_CONTINUE;
     }
 
+    static gboolean _sample(gpointer user_data)
+    {
+        ApplicationManager::getInstance().updateMemory();
+        FreezeManager::getInstance().freezeIdle();
+        PreloadManager::getInstance().update();
+        return G_SOURCE_CONTINUE;
+    }
+
+    static gboolean _reclaim(gpointer user_data)
+    {
+        MemoryManager::getInstance().reclaim();
+        return G_SOURCE_CONTINUE;
+    }
+
     MemoryManager();
 
+    void updateTick();
+
+    // requireMemory state machine
+    void reclaim();
+
     GMainLoop* m_mainloop;
     guint m_tickSrc;
+    int m_tickInterval;
+    guint m_sampleSrc;
+
+    MemoryPolicy m_policy;
+    // Pending requireMemory requests by the id given to the policy
+    map<unsigned long, Message> m_requests;
+    unsigned long m_nextRequestId;
+    guint m_reclaimSrc;
 
 };
 
@@ -156,9 +156,10 @@ void Application::fromApplication(Application& application)
 {
     m_appId = application.m_appId;
 
-    if (application.m_tid != -1) {
+    if (application.m_tid != -1 && application.m_tid != m_tid) {
         m_tid = application.m_tid;
-        Process::fromPid(m_tid, m_process);
+        m_processGroup.setLeader(m_tid);
+        m_processGroup.update();
     }
 
     if (application.m_windowType != WindowType_Unknown) {
@@ -174,15 +175,27 @@ void Application::fromApplication(Application& application)
     }
 }
 
+bool Application::updateMemory()
+{
+    if (m_tid <= 0)
+        return false;
+    if (m_cgroup.isValid())
+        m_cgroup.update();
+    return m_processGroup.update();
+}
+
 void Application::print()
 {
     string msg = "STATUS(" + toString(m_applicationStatus) + ") ";
     msg += "TIME(" + to_string(m_time) + ") ";
     msg += "PID(" + to_string(m_tid) + ") ";
     msg += "WINDOW(" + toString(m_windowType) + ") ";
-    msg += "TYPE(" + toString(m_applicationType) + ")";
+    msg += "TYPE(" + toString(m_applicationType) + ") ";
+    msg += "PROCESSES(" + to_string(m_processGroup.getProcesses().size()) + ") ";
+    msg += "PSS(" + to_string(m_processGroup.getPss()) + "KB) ";
+    msg += "RECLAIMABLE(" + to_string(m_processGroup.getReclaimable()) + "KB)";
 
-    Logger::verbose(msg, m_appId);
+    LOG_VERBOSE(msg, m_appId);
 }
 
 void Application::print(JValue& json)
@@ -192,4 +205,11 @@ void Application::print(JValue& json)
     json.put("type", toString(m_applicationType));
     json.put("status", toString(m_applicationStatus));
     json.put("time", m_time);
+    m_processGroup.print(json);
+
+    if (m_cgroup.isValid()) {
+        JValue cgroup = pbnjson::Object();
+        m_cgroup.print(cgroup);
+        json.put("cgroup", cgroup);
+    }
 }
@@ -21,8 +21,9 @@
 #include <algorithm>
 #include <pbnjson.hpp>
 
-#include "Process.h"
+#include "ProcessGroup.h"
 #include "base/IPrintable.h"
+#include "cgroup/MemoryCgroup.h"
 #include "util/Time.h"
 
 using namespace std;
@@ -76,22 +77,6 @@ public:
         return application.m_isRemoved;
     }
 
-    static vector<Application>::iterator find(vector<Application>& applications, string appId)
-    {
-        vector<Application>::iterator it;
-        it = find_if(applications.begin(), applications.end(),
-                     [&] (const Application& application) { return application.getAppId() == appId; } );
-        return it;
-    }
-
-    static bool isExist(vector<Application>& applications, string appId)
-    {
-        auto it = find(applications, appId);
-        if (it == applications.end())
-            return false;
-        return true;
-    }
-
     Application();
     virtual ~Application();
 
@@ -130,6 +115,37 @@ public:
         m_time = Time::getSystemTime();
     }
 
+    // Refreshes members and memory usage of the application process group
+    bool updateMemory();
+
+    // KB. Memory of an application without processes (memorymanager-sim)
+    void setMemory(long memory)
+    {
+        m_processGroup.setMemory(memory);
+    }
+
+    const ProcessGroup& getProcessGroup() const
+    {
+        return m_processGroup;
+    }
+
+    MemoryCgroup& getCgroup()
+    {
+        return m_cgroup;
+    }
+
+    void setCgroupPath(const string& path)
+    {
+        m_cgroup.setPath(path);
+        m_processGroup.setCgroup(path);
+    }
+
+    // KB (sum of the process group)
+    long getReclaimable() const
+    {
+        return m_processGroup.getReclaimable();
+    }
+
     void removed()
     {
         m_isRemoved = true;
@@ -145,6 +161,11 @@ public:
         m_isClosing = true;
     }
 
+    void notClosing()
+    {
+        m_isClosing = false;
+    }
+
     bool isClosing()
     {
         return m_isClosing;
@@ -162,7 +183,8 @@ private:
     enum ApplicationType m_applicationType;
     enum ApplicationStatus m_applicationStatus;
 
-    Process m_process;
+    ProcessGroup m_processGroup;
+    MemoryCgroup m_cgroup;
 
     // runtime value
     int m_time;
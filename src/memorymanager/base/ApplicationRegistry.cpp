@@ -0,0 +1,72 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ApplicationRegistry.h"
+
+ApplicationRegistry::ApplicationRegistry()
+{
+}
+
+ApplicationRegistry::~ApplicationRegistry()
+{
+    clear();
+}
+
+Application* ApplicationRegistry::find(const string& appId)
+{
+    auto it = m_applications.find(appId);
+    if (it == m_applications.end())
+        return nullptr;
+    return &it->second;
+}
+
+bool ApplicationRegistry::isExist(const string& appId)
+{
+    return (m_applications.find(appId) != m_applications.end());
+}
+
+Application& ApplicationRegistry::update(Application& application, bool touch)
+{
+    auto it = m_applications.find(application.getAppId());
+    if (it == m_applications.end()) {
+        it = m_applications.emplace(application.getAppId(), Application()).first;
+    } else {
+        m_order.erase(&it->second);
+    }
+
+    it->second.fromApplication(application);
+    if (touch)
+        it->second.updateTime();
+    m_order.insert(&it->second);
+    return it->second;
+}
+
+bool ApplicationRegistry::remove(const string& appId)
+{
+    auto it = m_applications.find(appId);
+    if (it == m_applications.end())
+        return false;
+
+    m_order.erase(&it->second);
+    m_applications.erase(it);
+    return true;
+}
+
+void ApplicationRegistry::clear()
+{
+    m_order.clear();
+    m_applications.clear();
+}
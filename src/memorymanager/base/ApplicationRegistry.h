@@ -0,0 +1,108 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BASE_APPLICATIONREGISTRY_H_
+#define BASE_APPLICATIONREGISTRY_H_
+
+#include <iostream>
+#include <set>
+#include <unordered_map>
+
+#include "Application.h"
+
+using namespace std;
+
+// Applications indexed by appId and ordered by 'Application::compare'.
+// Lookups are O(1) and reordering an application is O(log n).
+// Members which affect the order must only be changed through 'update'.
+class ApplicationRegistry {
+public:
+    struct Order {
+        bool operator()(const Application* a, const Application* b) const
+        {
+            if (Application::compare(*a, *b))
+                return true;
+            if (Application::compare(*b, *a))
+                return false;
+            // Keep applications with the same priority distinct
+            return a->getAppId() < b->getAppId();
+        }
+    };
+
+    typedef set<Application*, Order>::const_iterator iterator;
+    typedef set<Application*, Order>::const_reverse_iterator reverse_iterator;
+
+    ApplicationRegistry();
+    virtual ~ApplicationRegistry();
+
+    Application* find(const string& appId);
+    bool isExist(const string& appId);
+
+    // Adds a new application or merges into the existing one.
+    // 'touch' updates the time of the application (e.g. foreground)
+    Application& update(Application& application, bool touch = false);
+    bool remove(const string& appId);
+    void clear();
+
+    // From the highest priority (foreground) to the lowest
+    iterator begin() const
+    {
+        return m_order.begin();
+    }
+
+    iterator end() const
+    {
+        return m_order.end();
+    }
+
+    // From the lowest priority
+    reverse_iterator rbegin() const
+    {
+        return m_order.rbegin();
+    }
+
+    reverse_iterator rend() const
+    {
+        return m_order.rend();
+    }
+
+    Application& front()
+    {
+        return **m_order.begin();
+    }
+
+    Application& back()
+    {
+        return **m_order.rbegin();
+    }
+
+    size_t size() const
+    {
+        return m_order.size();
+    }
+
+    bool empty() const
+    {
+        return m_order.empty();
+    }
+
+private:
+    // Node based. Pointers are stable across rehashing.
+    unordered_map<string, Application> m_applications;
+    set<Application*, Order> m_order;
+};
+
+#endif /* BASE_APPLICATIONREGISTRY_H_ */
@@ -15,6 +15,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Process.h"
+
+#include <unistd.h>
+
 #include "util/Logger.h"
 
 #define LOG_NAME    "Process"
@@ -27,11 +30,13 @@ bool Process::fromPid(pid_t pid, Process& process)
 
     proc_t processInfo;
     memset(&processInfo, 0, sizeof(processInfo));
+    bool found = false;
     if (readproc(proc, &processInfo) != NULL) {
         process.fromProc(processInfo);
+        found = true;
     }
     closeproc(proc);
-    return false;
+    return found;
 }
 
 Process::Process()
@@ -44,6 +49,7 @@ Process::Process()
     , m_text(-1)
     , m_data(-1)
 {
+    memset(&m_smaps, -1, sizeof(m_smaps));
 }
 
 Process::~Process()
@@ -53,7 +59,7 @@ Process::~Process()
 void Process::fromProc(proc_t& processInfo)
 {
     if (m_ppid != -1 && m_ppid != processInfo.ppid) {
-        Logger::error("Invalid request", LOG_NAME);
+        LOG_ERROR("Invalid request", LOG_NAME);
         return;
     }
     m_ppid = processInfo.ppid;
@@ -66,6 +72,13 @@ void Process::fromProc(proc_t& processInfo)
     m_data = processInfo.drs;
 }
 
+bool Process::update()
+{
+    if (m_tid <= 0)
+        return false;
+    return Proc::getSmapsRollup(m_tid, m_smaps);
+}
+
 void Process::setPpid(int pid)
 {
     m_ppid = pid;
@@ -124,7 +137,12 @@ int Process::getRss() const
 
 int Process::getPss() const
 {
-    return m_rss - m_shared;
+    if (m_smaps.pss >= 0)
+        return m_smaps.pss;
+    if (m_rss < 0 || m_shared < 0)
+        return 0;
+    // Approximation with statm values (pages)
+    return (m_rss - m_shared) * (sysconf(_SC_PAGESIZE) / 1024);
 }
 
 int Process::getShared()
@@ -152,19 +170,49 @@ int Process::getData()
     return m_data;
 }
 
+long Process::getUss() const
+{
+    if (m_smaps.privateClean < 0 || m_smaps.privateDirty < 0)
+        return 0;
+    return m_smaps.privateClean + m_smaps.privateDirty;
+}
+
+long Process::getSwap() const
+{
+    return m_smaps.swap > 0 ? m_smaps.swap : 0;
+}
+
+long Process::getSwapPss() const
+{
+    return m_smaps.swapPss > 0 ? m_smaps.swapPss : 0;
+}
+
+long Process::getReclaimable() const
+{
+    // Private pages and the proportional share of swap are freed on exit
+    return getUss() + getSwapPss();
+}
+
 void Process::print()
 {
-    Logger::verbose("PPID - " + to_string(m_ppid), LOG_NAME);
-    Logger::verbose("TID - " + to_string(m_tid), LOG_NAME);
-    Logger::verbose("CMD - " + m_cmd, LOG_NAME);
-    Logger::verbose("SIZE - " + to_string(m_size), LOG_NAME);
-    Logger::verbose("RSS - " + to_string(m_rss), LOG_NAME);
-    Logger::verbose("SHARED - " + to_string(m_shared), LOG_NAME);
-    Logger::verbose("TEXT - " + to_string(m_text), LOG_NAME);
-    Logger::verbose("DATA - " + to_string(m_data), LOG_NAME);
+    LOG_VERBOSE("PPID - " + to_string(m_ppid), LOG_NAME);
+    LOG_VERBOSE("TID - " + to_string(m_tid), LOG_NAME);
+    LOG_VERBOSE("CMD - " + m_cmd, LOG_NAME);
+    LOG_VERBOSE("SIZE - " + to_string(m_size), LOG_NAME);
+    LOG_VERBOSE("RSS - " + to_string(m_rss), LOG_NAME);
+    LOG_VERBOSE("SHARED - " + to_string(m_shared), LOG_NAME);
+    LOG_VERBOSE("TEXT - " + to_string(m_text), LOG_NAME);
+    LOG_VERBOSE("DATA - " + to_string(m_data), LOG_NAME);
+    LOG_VERBOSE("PSS - " + to_string(getPss()), LOG_NAME);
+    LOG_VERBOSE("USS - " + to_string(getUss()), LOG_NAME);
+    LOG_VERBOSE("SWAP - " + to_string(getSwap()), LOG_NAME);
 }
 
 void Process::print(JValue& json)
 {
-    // No implmeneted yet
+    // MB
+    json.put("pss", (int)(getPss() / 1024));
+    json.put("uss", (int)(getUss() / 1024));
+    json.put("swap", (int)(getSwap() / 1024));
+    json.put("reclaimable", (int)(getReclaimable() / 1024));
 }
@@ -24,6 +24,7 @@
 #include <string.h>
 
 #include "base/IPrintable.h"
+#include "util/Proc.h"
 
 using namespace std;
 
@@ -49,7 +50,8 @@ public:
     Process();
     virtual ~Process();
 
-    void update();
+    // Reads smaps_rollup of the process
+    bool update();
 
     void fromProc(proc_t& processInfo);
 
@@ -67,6 +69,7 @@ public:
 
     void setRss(int rss);
     int getRss() const;
+    // KB
     int getPss() const;
 
     void setShared(int shared);
@@ -78,6 +81,12 @@ public:
     void setData(int data);
     int getData();
 
+    // KB (from smaps_rollup)
+    long getUss() const;
+    long getSwap() const;
+    long getSwapPss() const;
+    long getReclaimable() const;
+
     virtual void print();
     virtual void print(JValue& json);
 
@@ -91,6 +100,8 @@ protected:
     int m_text;
     int m_data;
 
+    SmapsRollupSnapshot m_smaps;
+
 };
 
 #endif /* BASE_PROCESS_H_ */
@@ -0,0 +1,228 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ProcessGroup.h"
+
+#include <algorithm>
+
+#include "util/Logger.h"
+#include "util/Proc.h"
+
+#define LOG_NAME    "ProcessGroup"
+
+ProcessGroup::ProcessGroup()
+    : m_leader(-1)
+    , m_cgroup("")
+    , m_pss(0)
+    , m_uss(0)
+    , m_swap(0)
+    , m_swapPss(0)
+{
+}
+
+ProcessGroup::~ProcessGroup()
+{
+}
+
+void ProcessGroup::setLeader(int pid)
+{
+    if (m_leader == pid)
+        return;
+    clear();
+    m_leader = pid;
+}
+
+int ProcessGroup::getLeader() const
+{
+    return m_leader;
+}
+
+void ProcessGroup::setCgroup(const string& cgroup)
+{
+    m_cgroup = cgroup;
+}
+
+const string& ProcessGroup::getCgroup() const
+{
+    return m_cgroup;
+}
+
+void ProcessGroup::scan(vector<int>& pids)
+{
+    if (!m_cgroup.empty() && Proc::getCgroupProcs(m_cgroup, pids) && !pids.empty())
+        return;
+
+    if (m_leader <= 0)
+        return;
+
+    pids.push_back(m_leader);
+
+    // Walk the ppid tree breadth first
+    bool supported = true;
+    for (size_t i = 0; i < pids.size(); ++i) {
+        if (!Proc::getChildren(pids[i], pids)) {
+            supported = false;
+            break;
+        }
+    }
+    if (supported)
+        return;
+
+    map<int, int> parents;
+    if (!Proc::getParents(parents))
+        return;
+
+    pids.clear();
+    pids.push_back(m_leader);
+    for (size_t i = 0; i < pids.size(); ++i) {
+        for (auto it = parents.begin(); it != parents.end(); ++it) {
+            if (it->second == pids[i])
+                pids.push_back(it->first);
+        }
+    }
+}
+
+bool ProcessGroup::update()
+{
+    vector<int> pids;
+    scan(pids);
+    std::sort(pids.begin(), pids.end());
+
+    // exited members
+    auto it = m_processes.begin();
+    while (it != m_processes.end()) {
+        if (std::binary_search(pids.begin(), pids.end(), it->first)) {
+            ++it;
+            continue;
+        }
+        LOG_VERBOSE("Process is gone - " + to_string(it->first), LOG_NAME);
+        subtract(it->second);
+        it = m_processes.erase(it);
+    }
+
+    for (auto pid = pids.begin(); pid != pids.end(); ++pid) {
+        auto member = m_processes.find(*pid);
+        if (member == m_processes.end()) {
+            LOG_VERBOSE("New process - " + to_string(*pid), LOG_NAME);
+            member = m_processes.insert(make_pair(*pid, Process())).first;
+            member->second.setTid(*pid);
+        } else {
+            subtract(member->second);
+        }
+
+        if (!member->second.update()) {
+            // exited during the scan
+            m_processes.erase(member);
+            continue;
+        }
+        add(member->second);
+    }
+    return !m_processes.empty();
+}
+
+bool ProcessGroup::isMember(int pid) const
+{
+    if (!m_cgroup.empty()) {
+        // 'm_cgroup' is the directory and '/proc/<pid>/cgroup' is relative to the mount point
+        string cgroup;
+        if (!Proc::getCgroup(pid, cgroup) || cgroup.empty() || cgroup.size() > m_cgroup.size())
+            return false;
+        return (m_cgroup.compare(m_cgroup.size() - cgroup.size(), cgroup.size(), cgroup) == 0);
+    }
+
+    if (pid == m_leader)
+        return true;
+    int ppid;
+    if (!Proc::getParent(pid, ppid))
+        return false;
+    return (ppid == m_leader || m_processes.find(ppid) != m_processes.end());
+}
+
+void ProcessGroup::clear()
+{
+    m_processes.clear();
+    m_pss = 0;
+    m_uss = 0;
+    m_swap = 0;
+    m_swapPss = 0;
+}
+
+void ProcessGroup::setMemory(long memory)
+{
+    clear();
+    m_pss = memory;
+    m_uss = memory;
+}
+
+void ProcessGroup::add(Process& process)
+{
+    m_pss += process.getPss();
+    m_uss += process.getUss();
+    m_swap += process.getSwap();
+    m_swapPss += process.getSwapPss();
+}
+
+void ProcessGroup::subtract(Process& process)
+{
+    m_pss -= process.getPss();
+    m_uss -= process.getUss();
+    m_swap -= process.getSwap();
+    m_swapPss -= process.getSwapPss();
+}
+
+long ProcessGroup::getPss() const
+{
+    return m_pss;
+}
+
+long ProcessGroup::getUss() const
+{
+    return m_uss;
+}
+
+long ProcessGroup::getSwap() const
+{
+    return m_swap;
+}
+
+long ProcessGroup::getSwapPss() const
+{
+    return m_swapPss;
+}
+
+long ProcessGroup::getReclaimable() const
+{
+    return m_uss + m_swapPss;
+}
+
+void ProcessGroup::print()
+{
+    LOG_VERBOSE("LEADER(" + to_string(m_leader) + ") " +
+                    "COUNT(" + to_string(m_processes.size()) + ") " +
+                    "PSS(" + to_string(m_pss) + "KB) " +
+                    "USS(" + to_string(m_uss) + "KB) " +
+                    "SWAP(" + to_string(m_swap) + "KB)", LOG_NAME);
+}
+
+void ProcessGroup::print(JValue& json)
+{
+    // MB
+    json.put("pss", (int)(m_pss / 1024));
+    json.put("uss", (int)(m_uss / 1024));
+    json.put("swap", (int)(m_swap / 1024));
+    json.put("reclaimable", (int)(getReclaimable() / 1024));
+    json.put("processes", (int)m_processes.size());
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BASE_PROCESSGROUP_H_
+#define BASE_PROCESSGROUP_H_
+
+#include <iostream>
+#include <map>
+
+#include "Process.h"
+#include "base/IPrintable.h"
+
+using namespace std;
+
+// All processes which belong to an application. Members are discovered
+// from the cgroup of the application if it is set, or the ppid tree of
+// the leader otherwise. Totals are updated incrementally.
+class ProcessGroup : public IPrintable {
+public:
+    ProcessGroup();
+    virtual ~ProcessGroup();
+
+    void setLeader(int pid);
+    int getLeader() const;
+
+    void setCgroup(const string& cgroup);
+    const string& getCgroup() const;
+
+    // Rescans members and samples memory of each member
+    bool update();
+    void clear();
+
+    // Sets the totals without members (memorymanager-sim). KB
+    void setMemory(long memory);
+
+    // Checks that 'pid' still belongs to the group (its cgroup or parent),
+    // so that a sampled pid which is reused by another process is not used
+    bool isMember(int pid) const;
+
+    const map<int, Process>& getProcesses() const
+    {
+        return m_processes;
+    }
+
+    // KB
+    long getPss() const;
+    long getUss() const;
+    long getSwap() const;
+    long getSwapPss() const;
+    long getReclaimable() const;
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    void scan(vector<int>& pids);
+    void add(Process& process);
+    void subtract(Process& process);
+
+    int m_leader;
+    string m_cgroup;
+    map<int, Process> m_processes;
+
+    long m_pss;
+    long m_uss;
+    long m_swap;
+    long m_swapPss;
+};
+
+#endif /* BASE_PROCESSGROUP_H_ */
@@ -0,0 +1,172 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "CgroupManager.h"
+
+#include <algorithm>
+
+#include "setting/SettingManager.h"
+#include "util/File.h"
+#include "util/Logger.h"
+#include "util/Proc.h"
+
+#define LOG_NAME    "CgroupManager"
+
+CgroupManager::CgroupManager()
+    : m_isAvailable(false)
+    , m_root("")
+{
+}
+
+CgroupManager::~CgroupManager()
+{
+}
+
+void CgroupManager::initialize(GMainLoop* mainloop)
+{
+    if (!SettingManager::getInstance().isCgroupEnabled())
+        return;
+
+    string mount = SettingManager::getInstance().getCgroupRoot();
+    if (!File::exists(mount + "/cgroup.controllers")) {
+        LOG_WARNING("cgroup v2 is not mounted on " + mount, LOG_NAME);
+        return;
+    }
+
+    m_root = mount + "/" + SettingManager::getInstance().getCgroupParent();
+    MemoryCgroup parent;
+    parent.setPath(m_root);
+    if (!enableMemoryController(mount) || !parent.create() || !enableMemoryController(m_root)) {
+        LOG_WARNING("Failed to prepare " + m_root, LOG_NAME);
+        return;
+    }
+    m_isAvailable = true;
+    LOG_NORMAL("Memory cgroups are created under " + m_root, LOG_NAME);
+}
+
+bool CgroupManager::isAvailable()
+{
+    return m_isAvailable;
+}
+
+bool CgroupManager::enableMemoryController(const string& path)
+{
+    string controllers;
+    if (File::readString(path + "/cgroup.subtree_control", controllers) &&
+        controllers.find("memory") != string::npos) {
+        return true;
+    }
+    return File::write(path + "/cgroup.subtree_control", "+memory");
+}
+
+string CgroupManager::toPath(const string& appId)
+{
+    // appId is reverse domain style. '/' is not allowed in a directory name.
+    string name = appId;
+    std::replace(name.begin(), name.end(), '/', '_');
+    return m_root + "/" + name;
+}
+
+bool CgroupManager::attach(Application& application)
+{
+    if (!m_isAvailable || application.getTid() <= 0)
+        return false;
+
+    string path = toPath(application.getAppId());
+    string current;
+    if (Proc::getCgroup(application.getTid(), current) &&
+        SettingManager::getInstance().getCgroupRoot() + current == path) {
+        // already attached. Children which are forked later stay in the cgroup.
+        return true;
+    }
+
+    MemoryCgroup& cgroup = application.getCgroup();
+    if (!cgroup.isValid()) {
+        cgroup.setPath(path);
+        if (!cgroup.create()) {
+            cgroup.setPath("");
+            return false;
+        }
+    }
+
+    // The process group is discovered from the ppid tree until it is attached
+    auto& processes = application.getProcessGroup().getProcesses();
+    cgroup.attach(application.getTid());
+    for (auto it = processes.begin(); it != processes.end(); ++it) {
+        if (it->first != application.getTid())
+            cgroup.attach(it->first);
+    }
+    application.setCgroupPath(path);
+    cgroup.update();
+    LOG_NORMAL("Attached to " + path, application.getAppId());
+    return true;
+}
+
+void CgroupManager::detach(Application& application)
+{
+    m_limits.erase(application.getAppId());
+
+    MemoryCgroup& cgroup = application.getCgroup();
+    if (!cgroup.isValid())
+        return;
+    cgroup.remove();
+}
+
+void CgroupManager::apply(Application& application, enum MemoryLevel level)
+{
+    MemoryCgroup& cgroup = application.getCgroup();
+    if (!m_isAvailable || !cgroup.isValid())
+        return;
+
+    int ratio = 0;
+    if (application.getApplicationStatus() != ApplicationStatus_Foreground) {
+        switch (level) {
+        case MemoryLevel_LOW:
+            ratio = SettingManager::getInstance().getCgroupLowRatio();
+            break;
+
+        case MemoryLevel_CRITICAL:
+            ratio = SettingManager::getInstance().getCgroupCriticalRatio();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (ratio <= 0) {
+        m_limits.erase(application.getAppId());
+        cgroup.setHigh(MemoryCgroup::UNLIMITED);
+        return;
+    }
+
+    // The kernel reclaims the cgroup down to 'memory.high' and throttles
+    // allocations above it. 'memory.current' follows the limit, so the limit
+    // is computed once when the level is entered and kept while it stays.
+    auto it = m_limits.find(application.getAppId());
+    if (it != m_limits.end() && it->second == level && cgroup.getHigh() != MemoryCgroup::UNLIMITED)
+        return;
+    if (cgroup.getCurrent() <= 0)
+        return;
+
+    // Only lower the limit (e.g. from LOW to CRITICAL)
+    long long high = cgroup.getCurrent() / 100 * ratio;
+    if (cgroup.getHigh() == MemoryCgroup::UNLIMITED || high < cgroup.getHigh()) {
+        if (!cgroup.setHigh(high))
+            return;
+    }
+    m_limits[application.getAppId()] = level;
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CGROUP_CGROUPMANAGER_H_
+#define CGROUP_CGROUPMANAGER_H_
+
+#include <iostream>
+#include <map>
+
+#include "base/Application.h"
+#include "base/IManager.h"
+#include "cgroup/MemoryCgroup.h"
+#include "memoryinfo/MemoryInfoManager.h"
+
+using namespace std;
+
+class CgroupManagerListener {
+public:
+    CgroupManagerListener() {};
+    virtual ~CgroupManagerListener() {};
+
+};
+
+// Places each application into its own cgroup v2 memory domain
+// '<root>/<parent>/<appId>' and throttles background applications
+// with 'memory.high' depending on the memory level.
+class CgroupManager : public IManager<CgroupManagerListener> {
+public:
+    static CgroupManager& getInstance()
+    {
+        static CgroupManager s_instance;
+        return s_instance;
+    }
+
+    virtual ~CgroupManager();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    bool isAvailable();
+
+    // Creates the cgroup of the application and moves its processes
+    bool attach(Application& application);
+    void detach(Application& application);
+
+    // Updates 'memory.high' of the application based on its status
+    void apply(Application& application, enum MemoryLevel level);
+
+private:
+    CgroupManager();
+
+    bool enableMemoryController(const string& path);
+    string toPath(const string& appId);
+
+    bool m_isAvailable;
+    string m_root;
+
+    // Level for which 'memory.high' of the application is set
+    map<string, enum MemoryLevel> m_limits;
+};
+
+#endif /* CGROUP_CGROUPMANAGER_H_ */
@@ -0,0 +1,235 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MemoryCgroup.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "util/File.h"
+#include "util/Logger.h"
+#include "util/ProcFields.h"
+
+#define LOG_NAME    "MemoryCgroup"
+
+const long long MemoryCgroup::UNLIMITED;
+
+static const ProcField STAT_FIELDS[] = {
+    PROC_FIELD("anon", MemoryCgroupStat, anon),
+    PROC_FIELD("file", MemoryCgroupStat, file),
+    PROC_FIELD("kernel_stack", MemoryCgroupStat, kernelStack),
+    PROC_FIELD("shmem", MemoryCgroupStat, shmem),
+    PROC_FIELD("file_mapped", MemoryCgroupStat, fileMapped),
+    PROC_FIELD("file_dirty", MemoryCgroupStat, fileDirty),
+    PROC_FIELD("file_writeback", MemoryCgroupStat, fileWriteback),
+    PROC_FIELD("inactive_anon", MemoryCgroupStat, inactiveAnon),
+    PROC_FIELD("active_anon", MemoryCgroupStat, activeAnon),
+    PROC_FIELD("inactive_file", MemoryCgroupStat, inactiveFile),
+    PROC_FIELD("active_file", MemoryCgroupStat, activeFile),
+    PROC_FIELD("unevictable", MemoryCgroupStat, unevictable),
+};
+
+static const ProcField EVENTS_FIELDS[] = {
+    PROC_FIELD("low", MemoryCgroupEvents, low),
+    PROC_FIELD("high", MemoryCgroupEvents, high),
+    PROC_FIELD("max", MemoryCgroupEvents, max),
+    PROC_FIELD("oom", MemoryCgroupEvents, oom),
+    PROC_FIELD("oom_kill", MemoryCgroupEvents, oomKill),
+};
+
+MemoryCgroup::MemoryCgroup()
+    : m_path("")
+    , m_current(0)
+    , m_high(UNLIMITED)
+    , m_max(UNLIMITED)
+{
+    memset(&m_stat, -1, sizeof(m_stat));
+    memset(&m_events, 0, sizeof(m_events));
+}
+
+MemoryCgroup::~MemoryCgroup()
+{
+}
+
+void MemoryCgroup::setPath(const string& path)
+{
+    m_path = path;
+}
+
+const string& MemoryCgroup::getPath() const
+{
+    return m_path;
+}
+
+bool MemoryCgroup::isValid() const
+{
+    return !m_path.empty();
+}
+
+bool MemoryCgroup::create()
+{
+    if (mkdir(m_path.c_str(), 0755) != 0 && errno != EEXIST) {
+        LOG_WARNING("Failed to create " + m_path + " - " + strerror(errno), LOG_NAME);
+        return false;
+    }
+    return true;
+}
+
+bool MemoryCgroup::remove()
+{
+    if (!isValid())
+        return false;
+
+    // Fails while processes are still alive in the cgroup
+    if (rmdir(m_path.c_str()) != 0 && errno != ENOENT) {
+        LOG_VERBOSE("Failed to remove " + m_path + " - " + strerror(errno), LOG_NAME);
+        return false;
+    }
+    return true;
+}
+
+bool MemoryCgroup::attach(int pid)
+{
+    if (!isValid())
+        return false;
+    return File::write(m_path + "/cgroup.procs", to_string(pid));
+}
+
+bool MemoryCgroup::update()
+{
+    if (!isValid())
+        return false;
+
+    if (!File::readLongLong(m_path + "/memory.current", m_current))
+        return false;
+    File::readLongLong(m_path + "/memory.high", m_high);
+    File::readLongLong(m_path + "/memory.max", m_max);
+
+    char buffer[4096];
+    ssize_t size = ProcFields::read((m_path + "/memory.stat").c_str(), buffer, sizeof(buffer));
+    if (size > 0) {
+        ProcFields::parse(buffer, size, STAT_FIELDS, sizeof(STAT_FIELDS) / sizeof(STAT_FIELDS[0]),
+                          &m_stat, false, ' ');
+    }
+
+    size = ProcFields::read((m_path + "/memory.events").c_str(), buffer, sizeof(buffer));
+    if (size > 0) {
+        ProcFields::parse(buffer, size, EVENTS_FIELDS, sizeof(EVENTS_FIELDS) / sizeof(EVENTS_FIELDS[0]),
+                          &m_events, false, ' ');
+    }
+    return true;
+}
+
+bool MemoryCgroup::writeLimit(const string& file, long long value)
+{
+    if (!isValid())
+        return false;
+    return File::write(m_path + "/" + file, value == UNLIMITED ? "max" : to_string(value));
+}
+
+bool MemoryCgroup::setHigh(long long high)
+{
+    if (m_high == high)
+        return true;
+    if (!writeLimit("memory.high", high))
+        return false;
+    m_high = high;
+    return true;
+}
+
+bool MemoryCgroup::setMax(long long max)
+{
+    if (m_max == max)
+        return true;
+    if (!writeLimit("memory.max", max))
+        return false;
+    m_max = max;
+    return true;
+}
+
+bool MemoryCgroup::isFreezable() const
+{
+    return isValid() && File::exists(m_path + "/cgroup.freeze");
+}
+
+bool MemoryCgroup::freeze(bool isFrozen)
+{
+    if (!isValid())
+        return false;
+    return File::write(m_path + "/cgroup.freeze", isFrozen ? "1" : "0");
+}
+
+bool MemoryCgroup::isReclaimable() const
+{
+    return isValid() && File::exists(m_path + "/memory.reclaim");
+}
+
+bool MemoryCgroup::reclaim(long long bytes)
+{
+    if (!isValid())
+        return false;
+    return File::write(m_path + "/memory.reclaim", to_string(bytes));
+}
+
+long long MemoryCgroup::getCurrent() const
+{
+    return m_current;
+}
+
+long long MemoryCgroup::getHigh() const
+{
+    return m_high;
+}
+
+long long MemoryCgroup::getMax() const
+{
+    return m_max;
+}
+
+const MemoryCgroupStat& MemoryCgroup::getStat() const
+{
+    return m_stat;
+}
+
+const MemoryCgroupEvents& MemoryCgroup::getEvents() const
+{
+    return m_events;
+}
+
+void MemoryCgroup::print()
+{
+    LOG_VERBOSE("PATH(" + m_path + ") " +
+                    "CURRENT(" + to_string(m_current / 1024) + "KB) " +
+                    "HIGH(" + to_string(m_high) + ") " +
+                    "EVENTS(high:" + to_string(m_events.high) + " oom_kill:" + to_string(m_events.oomKill) + ")", LOG_NAME);
+}
+
+void MemoryCgroup::print(JValue& json)
+{
+    // MB, -1 for unlimited
+    json.put("current", (int)(m_current / 1024 / 1024));
+    json.put("high", (int)(m_high == UNLIMITED ? UNLIMITED : m_high / 1024 / 1024));
+    json.put("max", (int)(m_max == UNLIMITED ? UNLIMITED : m_max / 1024 / 1024));
+
+    JValue events = pbnjson::Object();
+    events.put("high", (int)m_events.high);
+    events.put("max", (int)m_events.max);
+    events.put("oom", (int)m_events.oom);
+    events.put("oomKill", (int)m_events.oomKill);
+    json.put("events", events);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CGROUP_MEMORYCGROUP_H_
+#define CGROUP_MEMORYCGROUP_H_
+
+#include <iostream>
+
+#include "base/IPrintable.h"
+
+using namespace std;
+
+// Bytes from 'memory.stat'. 'long' is too small on 32bit systems. Fields which are not provided remain -1.
+struct MemoryCgroupStat {
+    long long anon;
+    long long file;
+    long long kernelStack;
+    long long shmem;
+    long long fileMapped;
+    long long fileDirty;
+    long long fileWriteback;
+    long long inactiveAnon;
+    long long activeAnon;
+    long long inactiveFile;
+    long long activeFile;
+    long long unevictable;
+};
+
+// Counters from 'memory.events'
+struct MemoryCgroupEvents {
+    long low;
+    long high;
+    long max;
+    long oom;
+    long oomKill;
+};
+
+// A cgroup v2 directory with the memory controller enabled
+class MemoryCgroup : public IPrintable {
+public:
+    static const long long UNLIMITED = -1;
+
+    MemoryCgroup();
+    virtual ~MemoryCgroup();
+
+    void setPath(const string& path);
+    const string& getPath() const;
+    bool isValid() const;
+
+    bool create();
+    bool remove();
+    bool attach(int pid);
+
+    // Reads 'memory.current', 'memory.stat' and 'memory.events'
+    bool update();
+
+    // Bytes. UNLIMITED is written as 'max'
+    bool setHigh(long long high);
+    bool setMax(long long max);
+
+    // Writes 'cgroup.freeze' (Linux 5.2)
+    bool isFreezable() const;
+    bool freeze(bool isFrozen);
+
+    // Writes 'memory.reclaim' (Linux 5.19). Fails if less than 'bytes' is reclaimed.
+    bool isReclaimable() const;
+    bool reclaim(long long bytes);
+
+    long long getCurrent() const;
+    long long getHigh() const;
+    long long getMax() const;
+    const MemoryCgroupStat& getStat() const;
+    const MemoryCgroupEvents& getEvents() const;
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    bool writeLimit(const string& file, long long value);
+
+    string m_path;
+
+    long long m_current;
+    long long m_high;
+    long long m_max;
+    MemoryCgroupStat m_stat;
+    MemoryCgroupEvents m_events;
+};
+
+#endif /* CGROUP_MEMORYCGROUP_H_ */
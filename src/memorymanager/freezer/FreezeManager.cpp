@@ -0,0 +1,264 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FreezeManager.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "luna/client/ApplicationManager.h"
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/PidFd.h"
+#include "util/Time.h"
+
+#define LOG_NAME            "FreezeManager"
+
+string FreezeManager::toString(enum FreezeMethod method)
+{
+    switch (method) {
+    case FreezeMethod_None:
+        return "none";
+
+    case FreezeMethod_Cgroup:
+        return "cgroup";
+
+    case FreezeMethod_Signal:
+        return "signal";
+    }
+    return "unknown";
+}
+
+FreezeManager::FreezeManager()
+    : m_generation(0)
+{
+}
+
+FreezeManager::~FreezeManager()
+{
+}
+
+void FreezeManager::initialize(GMainLoop* mainloop)
+{
+}
+
+void FreezeManager::update(Application& application)
+{
+    switch (application.getApplicationStatus()) {
+    case ApplicationStatus_Foreground:
+        thaw(application);
+        m_records.erase(application.getAppId());
+        break;
+
+    case ApplicationStatus_Background:
+        // The idle time starts when it is seen in the background first
+        getRecord(application.getAppId());
+        break;
+
+    default:
+        break;
+    }
+}
+
+void FreezeManager::freezeIdle()
+{
+    if (!SettingManager::getInstance().isFreezerEnabled())
+        return;
+
+    long long now = Time::getSystemTimeInMs();
+    long long idleTime = SettingManager::getInstance().getFreezerIdleTime();
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        if (it->second.method != FreezeMethod_None || now - it->second.idleTime < idleTime)
+            continue;
+
+        Application* application = applications.find(it->first);
+        if (application == nullptr ||
+            application->getApplicationStatus() != ApplicationStatus_Background ||
+            application->isClosing())
+            continue;
+        freeze(*application);
+    }
+}
+
+void FreezeManager::freezeAll()
+{
+    if (!SettingManager::getInstance().isFreezerEnabled())
+        return;
+
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = applications.begin(); it != applications.end(); ++it) {
+        Application& application = **it;
+        if (application.getApplicationStatus() != ApplicationStatus_Background || application.isClosing())
+            continue;
+        freeze(application);
+    }
+}
+
+bool FreezeManager::freeze(Application& application)
+{
+    Record& record = getRecord(application.getAppId());
+    if (record.method != FreezeMethod_None)
+        return true;
+
+    enum FreezeMethod method = FreezeMethod_Signal;
+    if (application.getCgroup().isFreezable())
+        method = FreezeMethod_Cgroup;
+
+    bool result = false;
+    if (method == FreezeMethod_Cgroup)
+        result = application.getCgroup().freeze(true);
+    else
+        result = stop(application, record);
+    if (!result) {
+        LOG_WARNING("Failed to freeze " + application.getAppId(), LOG_NAME);
+        return false;
+    }
+
+    record.method = method;
+    m_generation++;
+    LOG_NORMAL("Frozen (" + toString(method) + ") - " + application.getAppId(), LOG_NAME);
+    return true;
+}
+
+bool FreezeManager::thaw(Application& application)
+{
+    auto it = m_records.find(application.getAppId());
+    if (it == m_records.end() || it->second.method == FreezeMethod_None)
+        return true;
+
+    bool result = false;
+    if (it->second.method == FreezeMethod_Cgroup)
+        result = application.getCgroup().freeze(false);
+    else
+        result = resume(it->second);
+    if (!result) {
+        LOG_WARNING("Failed to thaw " + application.getAppId(), LOG_NAME);
+        return false;
+    }
+
+    // It is frozen again after it is idle again
+    it->second.method = FreezeMethod_None;
+    it->second.idleTime = Time::getSystemTimeInMs();
+    m_generation++;
+    LOG_NORMAL("Thawed - " + application.getAppId(), LOG_NAME);
+    return true;
+}
+
+bool FreezeManager::isFrozen(const string& appId)
+{
+    auto it = m_records.find(appId);
+    return (it != m_records.end() && it->second.method != FreezeMethod_None);
+}
+
+void FreezeManager::remove(const string& appId)
+{
+    if (m_records.erase(appId) > 0)
+        m_generation++;
+}
+
+bool FreezeManager::stop(Application& application, Record& record)
+{
+    // Members are sampled every 'sampleInterval'. Children which are forked
+    // since then must be stopped too, and exited pids can be reused.
+    application.updateMemory();
+    const map<int, Process>& processes = application.getProcessGroup().getProcesses();
+    if (processes.empty())
+        return false;
+
+    bool result = true;
+    record.stopped.clear();
+    for (auto it = processes.begin(); it != processes.end(); ++it) {
+        int pidfd = PidFd::open(it->first);
+        if (pidfd < 0 && errno == ESRCH)
+            continue;
+
+        // The pidfd pins the process while it is checked
+        if (!application.getProcessGroup().isMember(it->first)) {
+            if (pidfd >= 0)
+                close(pidfd);
+            continue;
+        }
+
+        int ret = (pidfd >= 0) ? PidFd::sendSignal(pidfd, SIGSTOP) : kill(it->first, SIGSTOP);
+        if (ret == 0) {
+            record.stopped.push_back(it->first);
+        } else if (errno != ESRCH) {
+            LOG_VERBOSE("Failed to stop " + to_string(it->first) + " - " + strerror(errno), LOG_NAME);
+            result = false;
+        }
+        if (pidfd >= 0)
+            close(pidfd);
+    }
+
+    if (!result || record.stopped.empty()) {
+        resume(record);
+        return false;
+    }
+    return true;
+}
+
+bool FreezeManager::resume(Record& record)
+{
+    // Exactly the processes which are stopped
+    bool result = true;
+    for (auto it = record.stopped.begin(); it != record.stopped.end(); ++it) {
+        if (kill(*it, SIGCONT) != 0 && errno != ESRCH) {
+            LOG_VERBOSE("Failed to continue " + to_string(*it) + " - " + strerror(errno), LOG_NAME);
+            result = false;
+        }
+    }
+    record.stopped.clear();
+    return result;
+}
+
+FreezeManager::Record& FreezeManager::getRecord(const string& appId)
+{
+    auto it = m_records.find(appId);
+    if (it == m_records.end()) {
+        Record record;
+        record.idleTime = Time::getSystemTimeInMs();
+        record.method = FreezeMethod_None;
+        it = m_records.insert(make_pair(appId, record)).first;
+    }
+    return it->second;
+}
+
+void FreezeManager::print()
+{
+    int frozen = 0;
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        if (it->second.method != FreezeMethod_None)
+            frozen++;
+    }
+    LOG_VERBOSE("BACKGROUND(" + to_string(m_records.size()) + ") FROZEN(" + to_string(frozen) + ")", LOG_NAME);
+}
+
+void FreezeManager::print(JValue& json)
+{
+    JValue frozen = pbnjson::Array();
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        if (it->second.method == FreezeMethod_None)
+            continue;
+        JValue item = pbnjson::Object();
+        item.put("appId", it->first);
+        item.put("method", toString(it->second.method));
+        frozen.append(item);
+    }
+    json.put("frozen", frozen);
+}
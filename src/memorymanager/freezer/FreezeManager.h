@@ -0,0 +1,110 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef FREEZER_FREEZEMANAGER_H_
+#define FREEZER_FREEZEMANAGER_H_
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "base/Application.h"
+#include "base/IManager.h"
+#include "base/IPrintable.h"
+
+using namespace std;
+using namespace pbnjson;
+
+enum FreezeMethod {
+    FreezeMethod_None,
+    // 'cgroup.freeze' of the application cgroup
+    FreezeMethod_Cgroup,
+    // SIGSTOP and SIGCONT to each process
+    FreezeMethod_Signal,
+};
+
+class FreezeManagerListener {
+public:
+    FreezeManagerListener() {};
+    virtual ~FreezeManagerListener() {};
+
+};
+
+// Freezes background applications which are idle or while the memory is
+// low, so that they neither allocate nor compete for CPU. They are thawed
+// when they come to the foreground or before they are closed.
+class FreezeManager : public IManager<FreezeManagerListener>,
+                      public IPrintable {
+public:
+    static string toString(enum FreezeMethod method);
+
+    static FreezeManager& getInstance()
+    {
+        static FreezeManager s_instance;
+        return s_instance;
+    }
+
+    virtual ~FreezeManager();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    // Follows the status of the application. Foreground ones are thawed.
+    void update(Application& application);
+    // Freezes background applications which are idle longer than 'idleTime'
+    void freezeIdle();
+    // Freezes all background applications
+    void freezeAll();
+    bool thaw(Application& application);
+    bool isFrozen(const string& appId);
+    // The application is terminated
+    void remove(const string& appId);
+
+    // Changed whenever printed values are changed
+    unsigned long getGeneration()
+    {
+        return m_generation;
+    }
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    struct Record {
+        // Since when the application is in the background (or thawed)
+        long long idleTime;
+        // FreezeMethod_None while not frozen
+        enum FreezeMethod method;
+        // Processes which are stopped by FreezeMethod_Signal
+        vector<int> stopped;
+    };
+
+    FreezeManager();
+
+    bool freeze(Application& application);
+    // SIGSTOP / SIGCONT
+    bool stop(Application& application, Record& record);
+    bool resume(Record& record);
+    Record& getRecord(const string& appId);
+
+    map<string, Record> m_records;
+    unsigned long m_generation;
+};
+
+#endif /* FREEZER_FREEZEMANAGER_H_ */
@@ -0,0 +1,252 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "KillTracker.h"
+
+#include <errno.h>
+#include <glib-unix.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/PidFd.h"
+#include "util/Proc.h"
+
+#define LOG_NAME    "KillTracker"
+
+gboolean KillTracker::_onExit(gint fd, GIOCondition condition, gpointer user_data)
+{
+    Watch* watch = (Watch*)user_data;
+    Target* target = watch->target;
+
+    LOG_VERBOSE("Process is exited - " + to_string(watch->pid), target->appId);
+
+    // Nothing to do if the address space is already released
+    PidFd::mrelease(watch->pidfd);
+
+    watch->src = 0;
+    KillTracker::getInstance().release(target, watch);
+    if (target->watches.empty())
+        KillTracker::getInstance().finish(target);
+    return G_SOURCE_REMOVE;
+}
+
+gboolean KillTracker::_onDeadline(gpointer user_data)
+{
+    Target* target = (Target*)user_data;
+    target->deadlineSrc = 0;
+    KillTracker::getInstance().escalate(target);
+    return G_SOURCE_REMOVE;
+}
+
+KillTracker::KillTracker()
+{
+}
+
+KillTracker::~KillTracker()
+{
+    while (!m_targets.empty()) {
+        untrack(m_targets.begin()->first);
+    }
+}
+
+void KillTracker::initialize(GMainLoop* mainloop)
+{
+}
+
+bool KillTracker::track(Application& application)
+{
+    if (application.getTid() <= 0 || isTracking(application.getAppId()))
+        return false;
+
+    // Members are sampled every 'sampleInterval'. Refresh them, so that
+    // forked children are tracked and exited pids are not.
+    application.updateMemory();
+
+    Target* target = new Target();
+    target->appId = application.getAppId();
+    target->stage = KillStage_Close;
+
+    auto& processes = application.getProcessGroup().getProcesses();
+    vector<pid_t> pids;
+    for (auto it = processes.begin(); it != processes.end(); ++it) {
+        pids.push_back(it->first);
+    }
+    if (pids.empty())
+        pids.push_back(application.getTid());
+
+    for (auto it = pids.begin(); it != pids.end(); ++it) {
+        int pidfd = PidFd::open(*it);
+        if (pidfd < 0 && errno == ESRCH)
+            continue;
+
+        // Without pidfd, the start time identifies the process instead
+        unsigned long long startTime = 0;
+        if (pidfd < 0 && !Proc::getStartTime(*it, startTime))
+            continue;
+
+        // The pidfd pins the process. Check that the pid is not reused
+        // since the scan, or a later SIGKILL hits an unrelated process.
+        if (!application.getProcessGroup().isMember(*it)) {
+            LOG_WARNING("Not a member anymore - " + to_string(*it), target->appId);
+            if (pidfd >= 0)
+                close(pidfd);
+            continue;
+        }
+
+        Watch* watch = new Watch();
+        watch->target = target;
+        watch->pid = *it;
+        watch->pidfd = pidfd;
+        watch->startTime = startTime;
+        watch->src = 0;
+        if (watch->pidfd >= 0) {
+            // pidfd becomes readable when the process exits
+            watch->src = g_unix_fd_add(watch->pidfd, G_IO_IN, _onExit, watch);
+        }
+        target->watches[*it] = watch;
+    }
+
+    if (target->watches.empty()) {
+        delete target;
+        return false;
+    }
+
+    target->deadlineSrc = g_timeout_add(SettingManager::getInstance().getKillDeadline(), _onDeadline, target);
+    m_targets[target->appId] = target;
+    return true;
+}
+
+void KillTracker::untrack(const string& appId)
+{
+    auto it = m_targets.find(appId);
+    if (it == m_targets.end())
+        return;
+
+    Target* target = it->second;
+    while (!target->watches.empty()) {
+        release(target, target->watches.begin()->second);
+    }
+    if (target->deadlineSrc > 0)
+        g_source_remove(target->deadlineSrc);
+    m_targets.erase(it);
+    delete target;
+}
+
+bool KillTracker::isTracking(const string& appId)
+{
+    return (m_targets.find(appId) != m_targets.end());
+}
+
+void KillTracker::escalate(Target* target)
+{
+    // Without pidfd, exits are only noticed here
+    auto it = target->watches.begin();
+    while (it != target->watches.end()) {
+        Watch* watch = it->second;
+        ++it;
+        if (watch->pidfd < 0 && !isSameProcess(watch))
+            release(target, watch);
+    }
+    if (target->watches.empty()) {
+        finish(target);
+        return;
+    }
+
+    switch (target->stage) {
+    case KillStage_Close:
+        LOG_WARNING("Application is not closed until deadline. Send SIGTERM", target->appId);
+        target->stage = KillStage_Term;
+        signal(target, SIGTERM);
+        if (target->watches.empty()) {
+            finish(target);
+            return;
+        }
+        target->deadlineSrc = g_timeout_add(SettingManager::getInstance().getKillTermTimeout(), _onDeadline, target);
+        break;
+
+    case KillStage_Term:
+        LOG_WARNING("Application is not terminated. Send SIGKILL", target->appId);
+        target->stage = KillStage_Kill;
+        signal(target, SIGKILL);
+        if (target->watches.empty()) {
+            finish(target);
+            return;
+        }
+        target->deadlineSrc = g_timeout_add(SettingManager::getInstance().getKillTermTimeout(), _onDeadline, target);
+        break;
+
+    case KillStage_Kill:
+        // D state or a zombie which is not reaped by its parent
+        LOG_ERROR("Application is not killed. Stop tracking", target->appId);
+        finish(target);
+        break;
+    }
+}
+
+void KillTracker::signal(Target* target, int signal)
+{
+    auto it = target->watches.begin();
+    while (it != target->watches.end()) {
+        Watch* watch = it->second;
+        ++it;
+        if (watch->pidfd < 0) {
+            // The pid was registered seconds ago and can be reused since
+            if (!isSameProcess(watch)) {
+                LOG_VERBOSE("Process is gone - " + to_string(watch->pid), target->appId);
+                release(target, watch);
+                continue;
+            }
+            kill(watch->pid, signal);
+        } else if (PidFd::sendSignal(watch->pidfd, signal) != 0 && errno == ENOSYS) {
+            // The pidfd keeps the pid from being reused
+            kill(watch->pid, signal);
+        }
+
+        // Reap the address space right away instead of waiting for the exit
+        if (signal == SIGKILL && watch->pidfd >= 0 && PidFd::mrelease(watch->pidfd) != 0) {
+            LOG_VERBOSE("process_mrelease - " + string(strerror(errno)), target->appId);
+        }
+    }
+}
+
+bool KillTracker::isSameProcess(Watch* watch)
+{
+    unsigned long long startTime;
+    return (Proc::getStartTime(watch->pid, startTime) && startTime == watch->startTime);
+}
+
+void KillTracker::release(Target* target, Watch* watch)
+{
+    target->watches.erase(watch->pid);
+    if (watch->src > 0)
+        g_source_remove(watch->src);
+    if (watch->pidfd >= 0)
+        close(watch->pidfd);
+    delete watch;
+}
+
+void KillTracker::finish(Target* target)
+{
+    string appId = target->appId;
+    untrack(appId);
+
+    LOG_NORMAL("Application is gone", appId);
+    if (m_listener)
+        m_listener->onKilled(appId);
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef KILL_KILLTRACKER_H_
+#define KILL_KILLTRACKER_H_
+
+#include <iostream>
+#include <map>
+#include <glib.h>
+
+#include "base/Application.h"
+#include "base/IManager.h"
+
+using namespace std;
+
+class KillTrackerListener {
+public:
+    KillTrackerListener() {};
+    virtual ~KillTrackerListener() {};
+
+    // All processes of the application are gone
+    virtual void onKilled(const string& appId) = 0;
+};
+
+// Watches the processes of closing applications with pidfds. If an
+// application is still alive after the deadline, it is terminated with
+// SIGTERM and then SIGKILL. The address space of a killed process is
+// reaped with process_mrelease() without waiting for its exit.
+class KillTracker : public IManager<KillTrackerListener> {
+public:
+    static KillTracker& getInstance()
+    {
+        static KillTracker s_instance;
+        return s_instance;
+    }
+
+    virtual ~KillTracker();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    bool track(Application& application);
+    void untrack(const string& appId);
+    bool isTracking(const string& appId);
+
+private:
+    enum KillStage {
+        KillStage_Close,
+        KillStage_Term,
+        KillStage_Kill
+    };
+
+    struct Target;
+
+    struct Watch {
+        Target* target;
+        pid_t pid;
+        int pidfd;
+        // Identifies the process if pidfd is not supported
+        unsigned long long startTime;
+        guint src;
+    };
+
+    struct Target {
+        string appId;
+        map<pid_t, Watch*> watches;
+        enum KillStage stage;
+        guint deadlineSrc;
+    };
+
+    static gboolean _onExit(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean _onDeadline(gpointer user_data);
+
+    KillTracker();
+
+    void escalate(Target* target);
+    void signal(Target* target, int signal);
+    bool isSameProcess(Watch* watch);
+    void release(Target* target, Watch* watch);
+    void finish(Target* target);
+
+    map<string, Target*> m_targets;
+};
+
+#endif /* KILL_KILLTRACKER_H_ */
@@ -16,12 +16,27 @@
 
 #include "LunaManager.h"
 
+#include <string.h>
+
 #include "client/ApplicationManager.h"
 #include "client/NotificationManager.h"
+#include "freezer/FreezeManager.h"
+#include "preload/PreloadManager.h"
+#include "profile/ProfileManager.h"
+#include "reclaim/ReclaimManager.h"
+#include "trim/TrimManager.h"
 #include "util/Logger.h"
+#include "util/Time.h"
 
 #define NAME    "LunaManager"
 
+// System services which act on behalf of applications (e.g. SAM and WAM)
+static const char* PRIVILEGED_SERVICES[] = {
+    "com.webos.service.",
+    "com.webos.surfacemanager",
+    "com.palm.webappmanager",
+};
+
 const string LunaManager::toString(enum ErrorCode code)
 {
     switch(code) {
@@ -46,18 +61,38 @@ const string LunaManager::toString(enum ErrorCode code)
     case ErrorCode_UnsupportedAPI:
         return "Unsupported API";
 
+    case ErrorCode_PermissionDenied:
+        return "Permission Denied";
+
     default:
         return "Unknown Error";
     }
     return "Unknown Error";
 }
 
+gboolean LunaManager::_postMemoryStatus(gpointer user_data)
+{
+    LunaManager* self = (LunaManager*)user_data;
+    self->m_memoryStatusSrc = 0;
+    self->flushMemoryStatus();
+    return G_SOURCE_REMOVE;
+}
+
 LunaManager::LunaManager()
+    : m_memoryStatusSrc(0)
+    , m_memoryStatusTime(0)
 {
+    m_memoryStatusCache.isValid = false;
+    m_memoryStatusCache.generation = 0;
 }
 
 LunaManager::~LunaManager()
 {
+    if (m_memoryStatusSrc > 0)
+        g_source_remove(m_memoryStatusSrc);
+    for (auto it = m_trimEvents.begin(); it != m_trimEvents.end(); ++it) {
+        delete it->second;
+    }
 }
 
 void LunaManager::initialize(GMainLoop* mainloop)
@@ -66,6 +101,8 @@ void LunaManager::initialize(GMainLoop* mainloop)
     m_newHandle.initialize(mainloop);
 
     m_memoryStatus.setServiceHandle(&m_newHandle);
+    m_memoryStatusDelta.setServiceHandle(&m_newHandle);
+    m_memoryStatusLevel.setServiceHandle(&m_newHandle);
     m_managerEventKilling.setServiceHandle(&m_newHandle);
 
     m_managerEventKillingAll.setServiceHandle(&m_oldHandle);
@@ -84,33 +121,200 @@ void LunaManager::signalLevelChanged(string prev, string cur)
 
 void LunaManager::postMemoryStatus()
 {
-    JValue subscriptionResponse = pbnjson::Object();
+    if (m_memoryStatusSrc > 0)
+        return;
 
-    if (m_listener->onMemoryStatus(subscriptionResponse)) {
+    // The first change is posted right away and later ones are merged
+    // until the interval is passed
+    long long elapsed = Time::getSystemTimeInMs() - m_memoryStatusTime;
+    long long interval = SettingManager::getInstance().getStatusPostInterval();
+    if (elapsed >= interval)
+        m_memoryStatusSrc = g_idle_add(_postMemoryStatus, this);
+    else
+        m_memoryStatusSrc = g_timeout_add(interval - elapsed, _postMemoryStatus, this);
+}
+
+void LunaManager::flushMemoryStatus()
+{
+    m_memoryStatusTime = Time::getSystemTimeInMs();
+
+    string level = MemoryInfoManager::toString(MemoryInfoManager::getInstance().getCurrentLevel());
+    if (level != m_lastLevel && m_memoryStatusLevel.getSubscribersCount() > 0) {
+        JValue subscriptionResponse = pbnjson::Object();
+        subscriptionResponse.put("level", level);
         subscriptionResponse.put("returnValue", true);
         subscriptionResponse.put("subscribed", true);
-        m_memoryStatus.post(subscriptionResponse.stringify().c_str());
+        m_memoryStatusLevel.post(subscriptionResponse.stringify().c_str());
+    }
+    m_lastLevel = level;
+
+    if (m_memoryStatus.getSubscribersCount() == 0 && m_memoryStatusDelta.getSubscribersCount() == 0) {
+        // Delta subscribers always start from a full payload
+        m_lastMemoryStatus = JValue();
+        return;
+    }
+
+    MemoryStatusCache& cache = getMemoryStatusCache();
+    if (!cache.isValid)
+        return;
+
+    if (m_memoryStatus.getSubscribersCount() > 0) {
+        m_memoryStatus.post(cache.subscriptionResponse.c_str());
     }
+
+    if (m_memoryStatusDelta.getSubscribersCount() > 0 && m_lastMemoryStatus.isObject()) {
+        JValue delta = diffMemoryStatus(m_lastMemoryStatus, cache.payload);
+        if (delta.isObject()) {
+            delta.put("delta", true);
+            delta.put("returnValue", true);
+            delta.put("subscribed", true);
+            m_memoryStatusDelta.post(delta.stringify().c_str());
+        }
+    }
+    m_lastMemoryStatus = cache.payload;
+}
+
+unsigned long LunaManager::getMemoryStatusGeneration()
+{
+    // All counters only grow. The sum is changed if one of them is changed.
+    return MemoryInfoManager::getInstance().getGeneration() +
+           ApplicationManager::getInstance().getGeneration() +
+           TrimManager::getInstance().getGeneration() +
+           ReclaimManager::getInstance().getGeneration() +
+           FreezeManager::getInstance().getGeneration() +
+           PreloadManager::getInstance().getGeneration();
+}
+
+LunaManager::MemoryStatusCache& LunaManager::getMemoryStatusCache()
+{
+    unsigned long generation = getMemoryStatusGeneration();
+    if (m_memoryStatusCache.isValid && m_memoryStatusCache.generation == generation)
+        return m_memoryStatusCache;
+
+    // The payload is never modified after it is cached
+    JValue payload = pbnjson::Object();
+    m_memoryStatusCache.isValid = m_listener->onMemoryStatus(payload);
+    m_memoryStatusCache.generation = generation;
+    payload.put("returnValue", true);
+    m_memoryStatusCache.response = payload.stringify();
+    payload.put("subscribed", true);
+    m_memoryStatusCache.subscriptionResponse = payload.stringify();
+    m_memoryStatusCache.payload = payload;
+    return m_memoryStatusCache;
 }
 
-void LunaManager::postManagerKillingEvent(Application& application)
+bool LunaManager::diffObject(JValue& prev, JValue& cur, JValue& delta)
+{
+    bool changed = false;
+    for (auto kv : cur.children()) {
+        string key = kv.first.asString();
+        if (!prev.hasKey(key) || prev[key] != kv.second) {
+            delta.put(key, kv.second);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+JValue LunaManager::diffMemoryStatus(JValue& prev, JValue& cur)
+{
+    JValue delta = pbnjson::Object();
+    bool changed = false;
+
+    // Changed members of top level objects except 'applications'
+    for (auto kv : cur.children()) {
+        string key = kv.first.asString();
+        if (key == "applications" || key == "returnValue" || key == "subscribed")
+            continue;
+        if (prev.hasKey(key) && prev[key].isObject() && kv.second.isObject()) {
+            JValue object = pbnjson::Object();
+            JValue prevObject = prev[key];
+            JValue curObject = kv.second;
+            if (diffObject(prevObject, curObject, object)) {
+                delta.put(key, object);
+                changed = true;
+            }
+        } else if (!prev.hasKey(key) || prev[key] != kv.second) {
+            delta.put(key, kv.second);
+            changed = true;
+        }
+    }
+
+    // Applications are matched by 'appId'. Changed ones only have changed fields.
+    map<string, JValue> prevApplications;
+    JValue prevOrder = pbnjson::Array();
+    for (JValue item : prev["applications"].items()) {
+        prevApplications[item["appId"].asString()] = item;
+        prevOrder.append(item["appId"]);
+    }
+
+    JValue applications = pbnjson::Array();
+    JValue order = pbnjson::Array();
+    for (JValue item : cur["applications"].items()) {
+        string appId = item["appId"].asString();
+        order.append(item["appId"]);
+
+        auto it = prevApplications.find(appId);
+        if (it == prevApplications.end()) {
+            applications.append(item);
+            continue;
+        }
+        JValue application = pbnjson::Object();
+        if (diffObject(it->second, item, application)) {
+            application.put("appId", appId);
+            applications.append(application);
+        }
+        prevApplications.erase(it);
+    }
+    if (applications.arraySize() > 0) {
+        delta.put("applications", applications);
+        changed = true;
+    }
+
+    if (!prevApplications.empty()) {
+        JValue removed = pbnjson::Array();
+        for (auto it = prevApplications.begin(); it != prevApplications.end(); ++it) {
+            removed.append(it->first);
+        }
+        delta.put("removed", removed);
+        changed = true;
+    }
+
+    if (order != prevOrder) {
+        delta.put("order", order);
+        changed = true;
+    }
+
+    if (!changed)
+        return JValue();
+    return delta;
+}
+
+void LunaManager::postManagerKillingEvent(Application& application, KillPlan* plan)
 {
     JValue subscriptionResponse = pbnjson::Object();
     subscriptionResponse.put("id", application.getAppId());
     subscriptionResponse.put("type", "killing");
+    subscriptionResponse.put("reclaimable", (int)(application.getReclaimable() / 1024));
+    if (plan) {
+        JValue planPayload = pbnjson::Object();
+        plan->print(planPayload);
+        subscriptionResponse.put("plan", planPayload);
+    }
     subscriptionResponse.put("returnValue", true);
     subscriptionResponse.put("subscribed", true);
 
-    m_managerEventKilling.post(subscriptionResponse.stringify().c_str());
-    m_managerEventKillingAll.post(subscriptionResponse.stringify().c_str());
+    string payload = subscriptionResponse.stringify();
+    m_managerEventKilling.post(payload.c_str());
+    m_managerEventKillingAll.post(payload.c_str());
 
     switch(application.getApplicationType()) {
     case ApplicationType_WebApp:
-        m_managerEventKillingWeb.post(subscriptionResponse.stringify().c_str());
+        m_managerEventKillingWeb.post(payload.c_str());
         break;
 
     case ApplicationType_Native:
-        m_managerEventKillingNative.post(subscriptionResponse.stringify().c_str());
+        m_managerEventKillingNative.post(payload.c_str());
         break;
 
     default:
@@ -123,18 +327,100 @@ void LunaManager::postManagerKillingEvent(Application& application)
     }
 }
 
-void LunaManager::getMemoryStatus(Message& request, JValue& requestPayload, JValue& responsePayload)
+bool LunaManager::postTrimEvent(const string& appId, const string& level, int target)
 {
-    if (request.isSubscription()) {
-        if (m_memoryStatus.subscribe(request)) {
-            responsePayload.put("subscribed", true);
-        } else {
-            responsePayload.put("subscribed", false);
+    if (!hasTrimSubscriber(appId))
+        return false;
+
+    JValue subscriptionResponse = pbnjson::Object();
+    subscriptionResponse.put("appId", appId);
+    subscriptionResponse.put("level", level);
+    subscriptionResponse.put("targetReduction", target);
+    subscriptionResponse.put("returnValue", true);
+    subscriptionResponse.put("subscribed", true);
+    return m_trimEvents[appId]->post(subscriptionResponse.stringify().c_str());
+}
+
+bool LunaManager::hasTrimSubscriber(const string& appId)
+{
+    auto it = m_trimEvents.find(appId);
+    if (it == m_trimEvents.end())
+        return false;
+    if (it->second->getSubscribersCount() > 0)
+        return true;
+
+    // All subscribers are cancelled
+    delete it->second;
+    m_trimEvents.erase(it);
+    return false;
+}
+
+void LunaManager::removeTrimEvent(const string& appId)
+{
+    auto it = m_trimEvents.find(appId);
+    if (it == m_trimEvents.end())
+        return;
+    delete it->second;
+    m_trimEvents.erase(it);
+}
+
+void LunaManager::getMemoryStatus(Message& request, JValue& requestPayload, JValue& responsePayload, string& response)
+{
+    string mode = "full";
+    if (!handleOptional(requestPayload, responsePayload, "mode", mode)) {
+        response = responsePayload.stringify();
+        return;
+    }
+
+    SubscriptionPoint* subscriptionPoint = nullptr;
+    if (mode == "full") {
+        subscriptionPoint = &m_memoryStatus;
+    } else if (mode == "delta") {
+        subscriptionPoint = &m_memoryStatusDelta;
+    } else if (mode == "level") {
+        subscriptionPoint = &m_memoryStatusLevel;
+    } else {
+        replyError(responsePayload, ErrorCode_InvalidParametersError);
+        response = responsePayload.stringify();
+        return;
+    }
+
+    if (mode == "delta" && request.isSubscription()) {
+        // Bring existing delta subscribers up to date. Then all of them
+        // share the payload of this response as the base.
+        if (m_memoryStatusSrc > 0) {
+            g_source_remove(m_memoryStatusSrc);
+            m_memoryStatusSrc = 0;
         }
+        flushMemoryStatus();
     }
 
-    m_listener->onMemoryStatus(responsePayload);
-    responsePayload.put("returnValue", true);
+    bool subscribed = false;
+    if (request.isSubscription()) {
+        subscribed = subscriptionPoint->subscribe(request);
+        responsePayload.put("subscribed", subscribed);
+    }
+
+    if (mode == "level") {
+        responsePayload.put("level", MemoryInfoManager::toString(MemoryInfoManager::getInstance().getCurrentLevel()));
+        responsePayload.put("returnValue", true);
+        response = responsePayload.stringify();
+        return;
+    }
+
+    MemoryStatusCache& cache = getMemoryStatusCache();
+    if (mode == "delta" && subscribed)
+        m_lastMemoryStatus = cache.payload;
+
+    if (!request.isSubscription()) {
+        response = cache.response;
+    } else if (subscribed) {
+        response = cache.subscriptionResponse;
+    } else {
+        JValue payload = cache.payload.duplicate();
+        payload.put("subscribed", false);
+        response = payload.stringify();
+    }
 }
 
 void LunaManager::getManagerEvent(Message& request, JValue& requestPayload, JValue& responsePayload)
@@ -168,72 +454,164 @@ void LunaManager::getManagerEvent(Message& request, JValue& requestPayload, JVal
     responsePayload.put("subscribed", true);
 }
 
-void LunaManager::requireMemory(Message& request, JValue& requestPayload, JValue& responsePayload)
+void LunaManager::getTrimEvent(Message& request, JValue& requestPayload, JValue& responsePayload)
+{
+    bool subscribe;
+    if (!handleRequired(requestPayload, responsePayload, "subscribe", subscribe)) {
+        return;
+    }
+
+    // Otherwise a caller can receive trim events of another application
+    // and delay its kill as a trim subscriber
+    string appId;
+    if (!handleAppId(request, requestPayload, responsePayload, appId)) {
+        return;
+    }
+
+    if (!subscribe || appId.empty()) {
+        replyError(responsePayload, ErrorCode_InvalidParametersError);
+        return;
+    }
+
+    // Entries of other applications whose subscribers are all cancelled
+    auto it = m_trimEvents.begin();
+    while (it != m_trimEvents.end()) {
+        if (it->first != appId && it->second->getSubscribersCount() == 0) {
+            delete it->second;
+            it = m_trimEvents.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    it = m_trimEvents.find(appId);
+    if (it == m_trimEvents.end()) {
+        SubscriptionPoint* point = new SubscriptionPoint();
+        point->setServiceHandle(&m_newHandle);
+        it = m_trimEvents.insert(make_pair(appId, point)).first;
+    }
+    it->second->subscribe(request);
+
+    responsePayload.put("returnValue", true);
+    responsePayload.put("subscribed", true);
+    responsePayload.put("appId", appId);
+}
+
+bool LunaManager::requireMemory(Message& request, JValue& requestPayload, JValue& responsePayload)
 {
     int requiredMemory;
     if (!handleRequired(requestPayload, responsePayload, "requiredMemory", requiredMemory)) {
-        return;
+        return true;
     }
 
     bool relaunch = false;
     if (!handleOptional(requestPayload, responsePayload, "relaunch", relaunch))
-        return;
+        return true;
 
-    bool returnValue = true;
-    string errorText = "";
     if (relaunch) {
-        goto Done;
+        responsePayload.put("returnValue", true);
+        return true;
+    }
+
+    string appId;
+    if (!handleAppId(request, requestPayload, responsePayload, appId))
+        return true;
+
+    // More than the whole memory can never be reclaimed
+    long total = MemoryInfoManager::getInstance().getMemInfo().memTotal / 1024;
+    if (total > 0 && requiredMemory > total) {
+        replyError(responsePayload, ErrorCode_InvalidParametersError);
+        return true;
     }
 
     if (requiredMemory <= 0) {
-        requiredMemory = SettingManager::getInstance().getDefaultRequiredMemory();
+        // Learned footprint of the application if it is known
+        requiredMemory = ProfileManager::getInstance().getRequiredMemory(appId,
+            SettingManager::getInstance().getDefaultRequiredMemory());
     }
 
-    returnValue = m_listener->onRequireMemory(requiredMemory, errorText);
+    // The response is sent when the memory is reclaimed
+    m_listener->onRequireMemory(request, requiredMemory);
+    return false;
+}
 
-Done:
+void LunaManager::replyRequireMemory(Message& request, bool returnValue, string errorText, int reclaimed)
+{
+    JValue responsePayload = pbnjson::Object();
     if (!returnValue) {
         responsePayload.put("errorText", errorText);
     }
+    if (request.isSubscription()) {
+        responsePayload.put("subscribed", false);
+    }
+    responsePayload.put("reclaimed", reclaimed);
     responsePayload.put("returnValue", returnValue);
+
+    logResponse(request, responsePayload, NAME);
+    request.respond(responsePayload.stringify().c_str());
+}
+
+void LunaManager::postRequireMemoryProgress(Message& request, int requiredMemory, int reclaimed)
+{
+    if (!request.isSubscription())
+        return;
+
+    JValue responsePayload = pbnjson::Object();
+    responsePayload.put("requiredMemory", requiredMemory);
+    responsePayload.put("reclaimed", reclaimed);
+    responsePayload.put("subscribed", true);
+    responsePayload.put("returnValue", true);
+
+    logResponse(request, responsePayload, NAME);
+    request.respond(responsePayload.stringify().c_str());
 }
 
 void LunaManager::logRequest(Message& request, JValue& requestPayload, string name)
 {
     if (SettingManager::getInstance().isVerbose()) {
-        Logger::normal("[Request] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")\n" +
-                       requestPayload.stringify("    ").c_str(), name);
+        LOG_NORMAL("[Request] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ") " +
+                       requestPayload.stringify().c_str(), name);
     } else {
-        Logger::normal("[Request] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")");
+        LOG_NORMAL("[Request] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")");
     }
 }
 
 void LunaManager::logResponse(Message& request, JValue& responsePayload, string name)
 {
     if (SettingManager::getInstance().isVerbose()) {
-        Logger::normal("[Response] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")\n" +
-                       responsePayload.stringify("    ").c_str(), name);
+        LOG_NORMAL("[Response] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ") " +
+                       responsePayload.stringify().c_str(), name);
     } else {
-        Logger::normal("[Response] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")");
+        LOG_NORMAL("[Response] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")");
+    }
+}
+
+void LunaManager::logResponse(Message& request, const string& response, string name)
+{
+    if (SettingManager::getInstance().isVerbose()) {
+        LOG_NORMAL("[Response] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ") " +
+                       response, name);
+    } else {
+        LOG_NORMAL("[Response] API(" + string(request.getMethod()) + ") Client(" + string(request.getSenderServiceName())+ ")");
     }
 }
 
 void LunaManager::logCall(string& url, JValue& callPayload)
 {
     if (SettingManager::getInstance().isVerbose()) {
-        Logger::normal("[Call] API(" + url + ")\n" + callPayload.stringify("    ").c_str(), NAME);
+        LOG_NORMAL("[Call] API(" + url + ") " + callPayload.stringify().c_str(), NAME);
     } else {
-        Logger::normal("[Call] API(" + url + ")", NAME);
+        LOG_NORMAL("[Call] API(" + url + ")", NAME);
     }
 }
 
 void LunaManager::logReturn(Message& response, JValue& returnPayload)
 {
     if (SettingManager::getInstance().isVerbose()) {
-        Logger::normal("[Return] Service(" + string(response.getSenderServiceName()) + ")\n" +
-                       returnPayload.stringify("    ").c_str(), NAME);
+        LOG_NORMAL("[Return] Service(" + string(response.getSenderServiceName()) + ") " +
+                       returnPayload.stringify().c_str(), NAME);
     } else {
-        Logger::normal("[Return] Service(" + string(response.getSenderServiceName()) + ")", NAME);
+        LOG_NORMAL("[Return] Service(" + string(response.getSenderServiceName()) + ")", NAME);
     }
 }
 
@@ -270,6 +648,42 @@ bool LunaManager::handleRequired(JValue& requestPayload, JValue& responsePayload
     return true;
 }
 
+bool LunaManager::isPrivileged(Message& request)
+{
+    // Applications are never privileged
+    if (request.getApplicationID() && request.getApplicationID()[0] != '\0')
+        return false;
+    if (!request.getSenderServiceName())
+        return false;
+
+    string service = request.getSenderServiceName();
+    for (size_t i = 0; i < sizeof(PRIVILEGED_SERVICES) / sizeof(PRIVILEGED_SERVICES[0]); ++i) {
+        if (service.compare(0, strlen(PRIVILEGED_SERVICES[i]), PRIVILEGED_SERVICES[i]) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool LunaManager::handleAppId(Message& request, JValue& requestPayload, JValue& responsePayload, string& appId)
+{
+    // Web applications call through WAM with their own application ID
+    if (request.getApplicationID() && request.getApplicationID()[0] != '\0')
+        appId = request.getApplicationID();
+    else if (request.getSenderServiceName())
+        appId = request.getSenderServiceName();
+    else
+        appId = "";
+
+    if (!requestPayload.hasKey("appId"))
+        return true;
+    if (!isPrivileged(request)) {
+        LOG_WARNING("'appId' is not allowed - " + appId, NAME);
+        replyError(responsePayload, ErrorCode_PermissionDenied);
+        return false;
+    }
+    return handleOptional(requestPayload, responsePayload, "appId", appId);
+}
+
 bool LunaManager::handleOptional(JValue& requestPayload, JValue& responsePayload, string key, string& value)
 {
     if (requestPayload.hasKey(key) && requestPayload[key].asString(value) != CONV_OK) {
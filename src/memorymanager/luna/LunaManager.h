@@ -24,6 +24,7 @@
 
 #include "base/Application.h"
 #include "base/IManager.h"
+#include "policy/KillPlanner.h"
 #include "luna/service/OldHandle.h"
 #include "luna/service/NewHandle.h"
 #include "setting/SettingManager.h"
@@ -39,7 +40,8 @@ enum ErrorCode {
     ErrorCode_NoRequiredParametersError,
     ErrorCode_InvalidParametersError,
     ErrorCode_LS2InternalError,
-    ErrorCode_UnsupportedAPI
+    ErrorCode_UnsupportedAPI,
+    ErrorCode_PermissionDenied
 };
 
 class LunaManagerListener {
@@ -47,7 +49,8 @@ public:
     LunaManagerListener() {};
     virtual ~LunaManagerListener() {};
 
-    virtual bool onRequireMemory(int requiredMemory, string& errorText) = 0;
+    // The listener owns the request and replies with 'replyRequireMemory'
+    virtual void onRequireMemory(Message& request, int requiredMemory) = 0;
     virtual bool onMemoryStatus(JValue& responsePayload) = 0;
 
 };
@@ -68,17 +71,30 @@ public:
     void signalLevelChanged(string prev, string cur);
 
     // Posts
+    // Memory status posts are coalesced into one per 'getStatusPostInterval'
     void postMemoryStatus();
-    void postManagerKillingEvent(Application& application);
+    void postManagerKillingEvent(Application& application, KillPlan* plan = nullptr);
+    // Returns false if the application has no subscriber
+    bool postTrimEvent(const string& appId, const string& level, int target);
+    bool hasTrimSubscriber(const string& appId);
+    // Drops the subscribers of a terminated application
+    void removeTrimEvent(const string& appId);
 
     // APIs
-    void getMemoryStatus(Message& request, JValue& requestPayload, JValue& responsePayload);
+    // 'response' is the serialized reply. It is shared while the status is not changed.
+    void getMemoryStatus(Message& request, JValue& requestPayload, JValue& responsePayload, string& response);
     void getManagerEvent(Message& request, JValue& requestPayload, JValue& responsePayload);
-    void requireMemory(Message& request, JValue& requestPayload, JValue& responsePayload);
+    void getTrimEvent(Message& request, JValue& requestPayload, JValue& responsePayload);
+    bool requireMemory(Message& request, JValue& requestPayload, JValue& responsePayload);
+
+    // Deferred replies
+    void replyRequireMemory(Message& request, bool returnValue, string errorText, int reclaimed);
+    void postRequireMemoryProgress(Message& request, int requiredMemory, int reclaimed);
 
     // Internal
     void logRequest(Message& request, JValue& requestPayload, string name);
     void logResponse(Message& request, JValue& responsePayload, string name);
+    void logResponse(Message& request, const string& response, string name);
     void logCall(string& url, JValue& callPayload);
     void logReturn(Message& response, JValue& returnPayload);
     void replyError(JValue& response, enum ErrorCode code);
@@ -86,6 +102,25 @@ public:
 private:
     static const string toString(enum ErrorCode code);
 
+    static gboolean _postMemoryStatus(gpointer user_data);
+
+    // Memory status payload which is serialized once per generation
+    struct MemoryStatusCache {
+        bool isValid;
+        unsigned long generation;
+        JValue payload;
+        string response;
+        string subscriptionResponse;
+    };
+
+    // Changed fields of 'cur' since 'prev'
+    static bool diffObject(JValue& prev, JValue& cur, JValue& delta);
+    static JValue diffMemoryStatus(JValue& prev, JValue& cur);
+
+    void flushMemoryStatus();
+    unsigned long getMemoryStatusGeneration();
+    MemoryStatusCache& getMemoryStatusCache();
+
     bool handleRequired(JValue& requestPayload, JValue& responsePayload, string key, string& value);
     bool handleRequired(JValue& requestPayload, JValue& responsePayload, string key, int& value);
     bool handleRequired(JValue& requestPayload, JValue& responsePayload, string key, bool& value);
@@ -93,18 +128,35 @@ private:
     bool handleOptional(JValue& requestPayload, JValue& responsePayload, string key, int& value);
     bool handleOptional(JValue& requestPayload, JValue& responsePayload, string key, bool& value);
 
+    // The caller itself. Only system services can name another one with 'appId'.
+    static bool isPrivileged(Message& request);
+    bool handleAppId(Message& request, JValue& requestPayload, JValue& responsePayload, string& appId);
+
     LunaManager();
 
     OldHandle m_oldHandle;
     NewHandle m_newHandle;
 
+    // getMemoryStatus subscribers by 'mode'
     SubscriptionPoint m_memoryStatus;
+    SubscriptionPoint m_memoryStatusDelta;
+    SubscriptionPoint m_memoryStatusLevel;
+
+    guint m_memoryStatusSrc;
+    long long m_memoryStatusTime;
+    JValue m_lastMemoryStatus;
+    MemoryStatusCache m_memoryStatusCache;
+    string m_lastLevel;
 
     SubscriptionPoint m_managerEventKilling;
     SubscriptionPoint m_managerEventKillingAll;
     SubscriptionPoint m_managerEventKillingWeb;
     SubscriptionPoint m_managerEventKillingNative;
 
+    // getTrimEvent subscribers by 'appId'.
+    // Entries are removed when all subscribers are cancelled.
+    map<string, SubscriptionPoint*> m_trimEvents;
+
 };
 
 #endif /* LUNA_LUNAMANAGER_H_ */
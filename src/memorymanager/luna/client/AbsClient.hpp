@@ -18,8 +18,11 @@
 #ifndef LUNA_CLIENT_ABSCLIENT_HPP_
 #define LUNA_CLIENT_ABSCLIENT_HPP_
 
+#include <functional>
 #include <iostream>
+#include <map>
 
+#include <glib.h>
 #include <luna-service2/lunaservice.hpp>
 #include <pbnjson.hpp>
 
@@ -30,18 +33,25 @@ using namespace std;
 using namespace pbnjson;
 using namespace LS;
 
+// 'returnPayload' is not valid if 'isSuccess' is false
+typedef function<void(bool isSuccess, JValue& returnPayload)> AsyncCallback;
+
 class AbsClient {
 public:
     AbsClient(string name)
         : m_name(name)
         , m_handle(nullptr)
         , m_timeout(5000)
+        , m_asyncToken(0)
     {
 
     }
 
     virtual ~AbsClient()
     {
+        while (!m_asyncCalls.empty()) {
+            cancelAsync(m_asyncCalls.begin()->first);
+        }
         if (m_serverStatus) {
             m_serverStatus.cancel();
         }
@@ -71,11 +81,11 @@ public:
         );
         auto reply = call.get(m_timeout);
         if (!reply) {
-            Logger::error("No reply during timeout");
+            LOG_ERROR("No reply during timeout");
             return false;
         }
         if (reply.isHubError()) {
-            Logger::error(reply.getPayload());
+            LOG_ERROR(reply.getPayload());
             return false;
         }
         returnPayload = JDomParser::fromString(reply.getPayload());
@@ -83,12 +93,60 @@ public:
         return true;
     }
 
+    // Returns a token for 'cancelAsync' or 0 if the call is failed.
+    // 'callback' is called on the main loop with the reply or after 'timeout' (ms).
+    unsigned long callAsync(string key, JValue& callPayload, AsyncCallback callback, int timeout = -1)
+    {
+        string url = "luna://" + m_name + "/" + key;
+
+        AsyncCall* asyncCall = new AsyncCall();
+        asyncCall->client = this;
+        asyncCall->token = ++m_asyncToken;
+        asyncCall->url = url;
+        asyncCall->callback = callback;
+        asyncCall->timeoutSrc = 0;
+
+        try {
+            LunaManager::getInstace().logCall(url, callPayload);
+            asyncCall->call = m_handle->callOneReply(
+                url.c_str(),
+                callPayload.stringify().c_str()
+            );
+            asyncCall->call.continueWith(_onAsyncReply, asyncCall);
+        }
+        catch (const LS::Error &e) {
+            LOG_ERROR(string(e.what()), m_name);
+            delete asyncCall;
+            return 0;
+        }
+
+        asyncCall->timeoutSrc = g_timeout_add(timeout > 0 ? timeout : m_timeout, _onAsyncTimeout, asyncCall);
+        m_asyncCalls[asyncCall->token] = asyncCall;
+        return asyncCall->token;
+    }
+
+    // The callback is not called for cancelled calls
+    void cancelAsync(unsigned long token)
+    {
+        auto it = m_asyncCalls.find(token);
+        if (it == m_asyncCalls.end())
+            return;
+
+        AsyncCall* asyncCall = it->second;
+        m_asyncCalls.erase(it);
+        if (asyncCall->timeoutSrc > 0)
+            g_source_remove(asyncCall->timeoutSrc);
+        if (asyncCall->call.isActive())
+            asyncCall->call.cancel();
+        delete asyncCall;
+    }
+
     bool subscribe(Call& call, string key, JValue& requestPayload, LSFilterFunc callback)
     {
         string url = "luna://" + m_name + "/" + key;
 
         if (call.isActive()) {
-            Logger::warning("The call is already active.", m_name);
+            LOG_WARNING("The call is already active.", m_name);
             call.cancel();
         }
 
@@ -101,7 +159,7 @@ public:
             call.continueWith(callback, this);
         }
         catch (const LS::Error &e) {
-            Logger::error(string(e.what()), m_name);
+            LOG_ERROR(string(e.what()), m_name);
             return false;
         }
         return true;
@@ -118,8 +176,71 @@ protected:
     int m_timeout;
 
 private:
+    struct AsyncCall {
+        AbsClient* client;
+        unsigned long token;
+        string url;
+        Call call;
+        AsyncCallback callback;
+        guint timeoutSrc;
+    };
+
+    static bool _onAsyncReply(LSHandle *sh, LSMessage *reply, void *ctx)
+    {
+        AsyncCall* asyncCall = (AsyncCall*)ctx;
+        AbsClient* client = asyncCall->client;
+        Message response(reply);
+        JValue returnPayload;
+        bool isSuccess = false;
+
+        if (response.isHubError()) {
+            LOG_ERROR(string(response.getPayload()), client->m_name);
+        } else {
+            returnPayload = JDomParser::fromString(response.getPayload());
+            LunaManager::getInstace().logReturn(response, returnPayload);
+            isSuccess = true;
+        }
+
+        if (asyncCall->timeoutSrc > 0) {
+            g_source_remove(asyncCall->timeoutSrc);
+            asyncCall->timeoutSrc = 0;
+        }
+        client->m_asyncCalls.erase(asyncCall->token);
+        asyncCall->callback(isSuccess, returnPayload);
+
+        // The call cannot be released in its own callback
+        g_idle_add(_onAsyncRelease, asyncCall);
+        return true;
+    }
+
+    static gboolean _onAsyncTimeout(gpointer ctx)
+    {
+        AsyncCall* asyncCall = (AsyncCall*)ctx;
+        AbsClient* client = asyncCall->client;
+
+        LOG_ERROR("No reply during timeout - " + asyncCall->url, client->m_name);
+        asyncCall->timeoutSrc = 0;
+        client->m_asyncCalls.erase(asyncCall->token);
+        if (asyncCall->call.isActive())
+            asyncCall->call.cancel();
+
+        JValue returnPayload;
+        asyncCall->callback(false, returnPayload);
+        delete asyncCall;
+        return G_SOURCE_REMOVE;
+    }
+
+    static gboolean _onAsyncRelease(gpointer ctx)
+    {
+        delete (AsyncCall*)ctx;
+        return G_SOURCE_REMOVE;
+    }
+
     ServerStatus m_serverStatus;
 
+    map<unsigned long, AsyncCall*> m_asyncCalls;
+    unsigned long m_asyncToken;
+
 };
 
 #endif /* LUNA_CLIENT_ABSCLIENT_HPP_ */
@@ -16,7 +16,14 @@
 
 #include "ApplicationManager.h"
 
+#include "cgroup/CgroupManager.h"
+#include "kill/KillTracker.h"
 #include "luna/LunaManager.h"
+#include "policy/KillPlanner.h"
+#include "freezer/FreezeManager.h"
+#include "profile/ProfileManager.h"
+#include "reclaim/ReclaimManager.h"
+#include "trim/TrimManager.h"
 #include "util/Logger.h"
 
 bool ApplicationManager::_getAppLifeEvents(LSHandle *sh, LSMessage *reply, void *ctx)
@@ -38,18 +45,18 @@ bool ApplicationManager::_getAppLifeEvents(LSHandle *sh, LSMessage *reply, void
         return false;
     }
 
-    auto it = Application::find(sam->m_applications, application.getAppId());
-    if (it == sam->m_applications.end()) {
-        sam->m_applications.emplace_back();
-        sam->m_applications.back().fromApplication(application);
+    bool isNew = !sam->m_applications.isExist(application.getAppId());
+    bool isForeground = (application.getApplicationStatus() == ApplicationStatus_Foreground);
+    Application& app = sam->m_applications.update(application, !isNew && isForeground);
+    sam->m_generation++;
+    CgroupManager::getInstance().attach(app);
+    FreezeManager::getInstance().update(app);
+    if (isNew)
         return true;
-    }
 
-    it->fromApplication(application);
+    CgroupManager::getInstance().apply(app, MemoryInfoManager::getInstance().getCurrentLevel());
 
-    if (application.getApplicationStatus() == ApplicationStatus_Foreground) {
-        it->updateTime();
-        std::sort(sam->m_applications.begin(), sam->m_applications.end(), Application::compare);
+    if (isForeground) {
         if (sam->m_listener) sam->m_listener->onApplicationsChanged();
         sam->print();
     }
@@ -68,33 +75,41 @@ bool ApplicationManager::_running(LSHandle *sh, LSMessage *reply, void *ctx)
     }
 
     for (auto it = sam->m_applications.begin(); it != sam->m_applications.end(); ++it) {
-        it->removed();
+        (*it)->removed();
     }
 
     Application application;
     for (JValue item : responsePayload["running"].items()) {
         application.fromJson(item);
 
-        auto it = Application::find(sam->m_applications, application.getAppId());
-        if (it == sam->m_applications.end()) {
-            sam->m_applications.emplace_back();
-            sam->m_applications.back().fromApplication(application);
-        } else {
-            it->fromApplication(application);
-            it->notRemoved();
-        }
+        Application& app = sam->m_applications.update(application);
+        app.notRemoved();
+        CgroupManager::getInstance().attach(app);
+        FreezeManager::getInstance().update(app);
     }
 
-    sam->m_applications.erase(std::remove_if(sam->m_applications.begin(),
-                                             sam->m_applications.end(),
-                                             Application::isRemoved),
-                              sam->m_applications.end());
+    vector<string> removed;
+    for (auto it = sam->m_applications.begin(); it != sam->m_applications.end(); ++it) {
+        if (Application::isRemoved(**it)) {
+            CgroupManager::getInstance().detach(**it);
+            removed.push_back((*it)->getAppId());
+        }
+    }
+    for (auto it = removed.begin(); it != removed.end(); ++it) {
+        ProfileManager::getInstance().finish(*it);
+        TrimManager::getInstance().remove(*it);
+        ReclaimManager::getInstance().remove(*it);
+        FreezeManager::getInstance().remove(*it);
+        sam->m_applications.remove(*it);
+    }
+    sam->m_generation++;
     if (sam->m_listener) sam->m_listener->onApplicationsChanged();
     return true;
 }
 
 ApplicationManager::ApplicationManager()
     : AbsClient("com.webos.applicationManager")
+    , m_generation(0)
     , m_listener(nullptr)
 {
 }
@@ -114,11 +129,14 @@ void ApplicationManager::clear()
     }
 }
 
-bool ApplicationManager::closeApp(bool includeForeground)
+bool ApplicationManager::closeApp(bool includeForeground, int requiredMemory)
 {
-    if (m_applications.size() == 0)
+    if (m_applications.empty())
         return false;
 
+    if (requiredMemory > 0)
+        return closeApps(includeForeground, requiredMemory);
+
     if (!includeForeground &&
         m_applications.back().getApplicationStatus() == ApplicationStatus_Foreground)
         return false;
@@ -126,15 +144,81 @@ bool ApplicationManager::closeApp(bool includeForeground)
     if (m_applications.back().isClosing())
         return true;
 
-    m_applications.back().closing();
-    LunaManager::getInstace().postManagerKillingEvent(m_applications.back());
-    string appId = m_applications.back().getAppId();
-    return closeByAppId(appId);
+    return close(m_applications.back().getAppId());
+}
+
+bool ApplicationManager::close(const string& appId)
+{
+    Application* application = m_applications.find(appId);
+    if (application == nullptr)
+        return false;
+    if (application->isClosing())
+        return true;
+
+    application->closing();
+    LunaManager::getInstace().postManagerKillingEvent(*application);
+    string id = appId;
+    return closeByAppId(id);
+}
+
+bool ApplicationManager::preload(const string& appId)
+{
+    JValue callPayload = pbnjson::Object();
+    callPayload.put("id", appId);
+    callPayload.put("preload", "full");
+
+    string id = appId;
+    unsigned long token = callAsync("launch", callPayload,
+        [this, id] (bool isSuccess, JValue& returnPayload) {
+            if (isSuccess && returnPayload["returnValue"].asBool())
+                return;
+            LOG_WARNING("Failed to preload " + id, m_name);
+        });
+    return (token != 0);
+}
+
+bool ApplicationManager::closeApps(bool includeForeground, int requiredMemory)
+{
+    KillPlan plan;
+    if (!KillPlanner::plan(m_applications, requiredMemory, includeForeground, plan))
+        return false;
+    plan.print();
+
+    // All victims are closed at once
+    bool result = true;
+    for (auto victim = plan.victims.begin(); victim != plan.victims.end(); ++victim) {
+        Application* application = m_applications.find(*victim);
+        if (application == nullptr)
+            continue;
+
+        application->closing();
+        LunaManager::getInstace().postManagerKillingEvent(*application, &plan);
+        string appId = application->getAppId();
+        result &= closeByAppId(appId);
+    }
+    return result;
+}
+
+void ApplicationManager::updateMemory()
+{
+    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
+        (*it)->updateMemory();
+        ProfileManager::getInstance().record(**it);
+    }
+    m_generation++;
+}
+
+void ApplicationManager::applyCgroups(enum MemoryLevel level)
+{
+    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
+        CgroupManager::getInstance().apply(**it, level);
+    }
+    m_generation++;
 }
 
 string ApplicationManager::getForegroundAppId()
 {
-    if (m_applications.size() == 0)
+    if (m_applications.empty())
         return "";
 
     if (m_applications.front().getApplicationStatus() == ApplicationStatus_Foreground)
@@ -150,7 +234,7 @@ int ApplicationManager::getRunningAppCount()
 bool ApplicationManager::onStatusChange(bool isConnected)
 {
     if (isConnected) {
-        Logger::normal("Connected", m_name);
+        LOG_NORMAL("Connected", m_name);
         running();
         getAppLifeEvents();
     } else {
@@ -181,18 +265,39 @@ bool ApplicationManager::closeByAppId(string& appId)
     callPayload.put("id", appId);
     callPayload.put("tryToMakeScreenshot", true);
 
-    JValue returnPayload;
-    return callSync("closeByAppId", callPayload, returnPayload);
+    // Kill completion is tracked from the close request.
+    // Frozen applications can not handle the request.
+    Application* application = m_applications.find(appId);
+    if (application != nullptr) {
+        FreezeManager::getInstance().thaw(*application);
+        KillTracker::getInstance().track(*application);
+    }
+
+    string id = appId;
+    unsigned long token = callAsync("closeByAppId", callPayload,
+        [this, id] (bool isSuccess, JValue& returnPayload) {
+            if (isSuccess && returnPayload["returnValue"].asBool())
+                return;
+            // The application can be selected again
+            LOG_WARNING("Failed to close " + id, m_name);
+            KillTracker::getInstance().untrack(id);
+            Application* application = m_applications.find(id);
+            if (application != nullptr)
+                application->notClosing();
+        });
+    if (token == 0)
+        KillTracker::getInstance().untrack(id);
+    return (token != 0);
 }
 
 void ApplicationManager::print()
 {
-    if (m_applications.size() == 0)
+    if (m_applications.empty())
         return;
     if (SettingManager::getInstance().isVerbose()) {
-        Logger::verbose("Ordered Application List", m_name);
+        LOG_VERBOSE("Ordered Application List", m_name);
         for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
-            it->print();
+            (*it)->print();
         }
     }
 }
@@ -202,7 +307,7 @@ void ApplicationManager::print(JValue& json)
     JValue array = pbnjson::Array();
     for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
         JValue item = pbnjson::Object();
-        it->print(item);
+        (*it)->print(item);
         array.append(item);
     }
     json.put("applications", array);
@@ -23,7 +23,9 @@
 #include <luna-service2/lunaservice.hpp>
 #include <pbnjson.hpp>
 
+#include "base/ApplicationRegistry.h"
 #include "base/IPrintable.h"
+#include "memoryinfo/MemoryInfoManager.h"
 #include "AbsClient.hpp"
 
 using namespace std;
@@ -50,9 +52,29 @@ public:
     virtual ~ApplicationManager();
 
     // public
-    bool closeApp(bool includeForeground = false);
+    // With requiredMemory (MB), all victims which are needed to reclaim it are closed at once.
+    // Otherwise the lowest priority application is closed.
+    bool closeApp(bool includeForeground = false, int requiredMemory = 0);
+    // Closes the given application regardless of its priority
+    bool close(const string& appId);
+    // Asks SAM to launch the application in the background without UI
+    bool preload(const string& appId);
+    void updateMemory();
+
+    // Applies 'memory.high' of application cgroups for the level
+    void applyCgroups(enum MemoryLevel level);
     string getForegroundAppId();
     int getRunningAppCount();
+    ApplicationRegistry& getApplications()
+    {
+        return m_applications;
+    }
+
+    // Changed whenever applications or their printed values are changed
+    unsigned long getGeneration()
+    {
+        return m_generation;
+    }
 
     virtual void setListener(ApplicationManagerListener* listener)
     {
@@ -71,6 +93,8 @@ private:
 
     virtual void clear();
 
+    bool closeApps(bool includeForeground, int requiredMemory);
+
     // AbsService
     virtual bool onStatusChange(bool isConnected);
 
@@ -79,7 +103,8 @@ private:
     bool running();
     bool closeByAppId(string& appId);
 
-    vector<Application> m_applications;
+    ApplicationRegistry m_applications;
+    unsigned long m_generation;
 
     Call m_getAppLifeEventsCall;
     Call m_runningCall;
@@ -39,7 +39,7 @@ bool NotificationManager::onStatusChange(bool isConnected)
 void NotificationManager::createToast(string message)
 {
     if (!m_isConnected) {
-        Logger::error("Notification service is not running", NAME);
+        LOG_ERROR("Notification service is not running", NAME);
         return;
     }
     JValue callPayload = pbnjson::Object();
@@ -47,6 +47,6 @@ void NotificationManager::createToast(string message)
     callPayload.put("sourceId", "com.webos.service.memorymanager");
     callPayload.put("message", message);
 
-    JValue returnPayload;
-    callSync("createToast", callPayload, returnPayload);
+    // Nobody waits for the toast
+    callAsync("createToast", callPayload, [] (bool isSuccess, JValue& returnPayload) {});
 }
@@ -33,6 +33,7 @@ NewHandle::NewHandle()
     LS_CATEGORY_BEGIN(NewHandle, "/")
         LS_CATEGORY_METHOD(getManagerEvent)
         LS_CATEGORY_METHOD(getMemoryStatus)
+        LS_CATEGORY_METHOD(getTrimEvent)
         LS_CATEGORY_METHOD(requireMemory)
     LS_CATEGORY_END
 
@@ -81,8 +82,25 @@ bool NewHandle::getMemoryStatus(LSMessage &message)
     JValue requestPayload = JDomParser::fromString(request.getPayload());
     JValue responsePayload = pbnjson::Object();
 
+    string response;
+
+    LunaManager::getInstace().logRequest(request, requestPayload, NAME_SERVICE);
+    LunaManager::getInstace().getMemoryStatus(request, requestPayload, responsePayload, response);
+    LunaManager::getInstace().logResponse(request, response, NAME_SERVICE);
+
+    request.respond(response.c_str());
+    return true;
+}
+
+bool NewHandle::getTrimEvent(LSMessage &message)
+{
+    Message request(&message);
+
+    JValue requestPayload = JDomParser::fromString(request.getPayload());
+    JValue responsePayload = pbnjson::Object();
+
     LunaManager::getInstace().logRequest(request, requestPayload, NAME_SERVICE);
-    LunaManager::getInstace().getMemoryStatus(request, requestPayload, responsePayload);
+    LunaManager::getInstace().getTrimEvent(request, requestPayload, responsePayload);
     LunaManager::getInstace().logResponse(request, responsePayload, NAME_SERVICE);
 
     request.respond(responsePayload.stringify().c_str());
@@ -97,7 +115,10 @@ bool NewHandle::requireMemory(LSMessage &message)
     JValue responsePayload = pbnjson::Object();
 
     LunaManager::getInstace().logRequest(request, requestPayload, NAME_SERVICE);
-    LunaManager::getInstace().requireMemory(request, requestPayload, responsePayload);
+    if (!LunaManager::getInstace().requireMemory(request, requestPayload, responsePayload)) {
+        // reply is deferred until the memory is reclaimed
+        return true;
+    }
     LunaManager::getInstace().logResponse(request, responsePayload, NAME_SERVICE);
 
     request.respond(responsePayload.stringify().c_str());
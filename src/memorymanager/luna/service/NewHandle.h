@@ -39,6 +39,7 @@ public:
 private:
     bool getManagerEvent(LSMessage& message);
     bool getMemoryStatus(LSMessage& message);
+    bool getTrimEvent(LSMessage& message);
     bool requireMemory(LSMessage& message);
 
     static const string NAME_SERVICE;
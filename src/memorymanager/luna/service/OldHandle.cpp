@@ -114,11 +114,13 @@ bool OldHandle::getCurrentMemState(LSMessage &message)
     JValue requestPayload = JDomParser::fromString(request.getPayload());
     JValue responsePayload = pbnjson::Object();
 
+    string response;
+
     LunaManager::getInstace().logRequest(request, requestPayload, NAME_SERVICE);
-    LunaManager::getInstace().getMemoryStatus(request, requestPayload, responsePayload);
-    LunaManager::getInstace().logResponse(request, responsePayload, NAME_SERVICE);
+    LunaManager::getInstace().getMemoryStatus(request, requestPayload, responsePayload, response);
+    LunaManager::getInstace().logResponse(request, response, NAME_SERVICE);
 
-    request.respond(responsePayload.stringify().c_str());
+    request.respond(response.c_str());
     return true;
 }
 
@@ -131,7 +133,10 @@ bool OldHandle::setRequiredMemory(LSMessage &message)
     JValue responsePayload = pbnjson::Object();
 
     LunaManager::getInstace().logRequest(request, requestPayload, NAME_SERVICE);
-    LunaManager::getInstace().requireMemory(request, requestPayload, responsePayload);
+    if (!LunaManager::getInstace().requireMemory(request, requestPayload, responsePayload)) {
+        // reply is deferred until the memory is reclaimed
+        return true;
+    }
     LunaManager::getInstace().logResponse(request, responsePayload, NAME_SERVICE);
 
     request.respond(responsePayload.stringify().c_str());
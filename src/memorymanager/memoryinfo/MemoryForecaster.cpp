@@ -0,0 +1,208 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MemoryForecaster.h"
+
+#include <math.h>
+
+#include "util/Logger.h"
+
+#define LOG_NAME    "MemoryForecaster"
+
+// Slopes over a shorter span are mostly noise
+#define MIN_SPAN    500
+
+string MemoryForecaster::toString(enum ForecastMethod method)
+{
+    switch (method) {
+    case ForecastMethod_Regression:
+        return "regression";
+
+    case ForecastMethod_EWMA:
+        return "ewma";
+    }
+    return "unknown";
+}
+
+void MemoryForecaster::toEnum(const string& str, enum ForecastMethod& method)
+{
+    if (str == "regression")
+        method = ForecastMethod_Regression;
+    else if (str == "ewma")
+        method = ForecastMethod_EWMA;
+}
+
+MemoryForecaster::MemoryForecaster()
+    : m_head(0)
+    , m_count(0)
+    , m_method(ForecastMethod_Regression)
+    , m_window(10000)
+    , m_alpha(30)
+    , m_ewma(0)
+    , m_hasEwma(false)
+    , m_printedSlope(0)
+    , m_printedValid(false)
+    , m_generation(0)
+{
+}
+
+MemoryForecaster::~MemoryForecaster()
+{
+}
+
+void MemoryForecaster::configure(enum ForecastMethod method, int window, int alpha)
+{
+    m_method = method;
+    m_window = window;
+    m_alpha = alpha;
+}
+
+void MemoryForecaster::clear()
+{
+    m_head = 0;
+    m_count = 0;
+    m_ewma = 0;
+    m_hasEwma = false;
+    m_printedSlope = 0;
+    m_printedValid = false;
+    m_generation++;
+}
+
+bool MemoryForecaster::add(long long time, long free)
+{
+    if (m_count > 0) {
+        const Sample& last = m_samples[(m_head + FORECAST_SAMPLE_COUNT - 1) % FORECAST_SAMPLE_COUNT];
+        if (time <= last.time)
+            return false;
+
+        double slope = (double)(free - last.free) * 1000 / (time - last.time);
+        if (m_hasEwma) {
+            m_ewma = (m_alpha * slope + (100 - m_alpha) * m_ewma) / 100;
+        } else {
+            m_ewma = slope;
+            m_hasEwma = true;
+        }
+    }
+
+    m_samples[m_head].time = time;
+    m_samples[m_head].free = free;
+    m_head = (m_head + 1) % FORECAST_SAMPLE_COUNT;
+    if (m_count < FORECAST_SAMPLE_COUNT)
+        m_count++;
+
+    // Most samples do not change the rounded slope once the window is full
+    bool isValid;
+    long slope = getPrintedSlope(isValid);
+    if (m_count < FORECAST_SAMPLE_COUNT || slope != m_printedSlope || isValid != m_printedValid) {
+        m_printedSlope = slope;
+        m_printedValid = isValid;
+        m_generation++;
+    }
+    return true;
+}
+
+long MemoryForecaster::getPrintedSlope(bool& isValid)
+{
+    double slope = 0;
+    isValid = getSlope(slope);
+    return isValid ? lround(slope * 10) : 0;
+}
+
+bool MemoryForecaster::getRegressionSlope(double& slope)
+{
+    if (m_count < 2)
+        return false;
+
+    // Times are relative to the latest sample to keep precision
+    int latest = (m_head + FORECAST_SAMPLE_COUNT - 1) % FORECAST_SAMPLE_COUNT;
+    long long now = m_samples[latest].time;
+
+    double sumT = 0, sumF = 0;
+    int count = 0;
+    long long span = 0;
+    for (int i = 0; i < m_count; ++i) {
+        const Sample& sample = m_samples[(latest + FORECAST_SAMPLE_COUNT - i) % FORECAST_SAMPLE_COUNT];
+        if (now - sample.time > m_window)
+            break;
+        sumT += (double)(sample.time - now) / 1000;
+        sumF += sample.free;
+        span = now - sample.time;
+        count++;
+    }
+    if (count < 2 || span < MIN_SPAN)
+        return false;
+
+    double meanT = sumT / count;
+    double meanF = sumF / count;
+    double sxy = 0, sxx = 0;
+    for (int i = 0; i < count; ++i) {
+        const Sample& sample = m_samples[(latest + FORECAST_SAMPLE_COUNT - i) % FORECAST_SAMPLE_COUNT];
+        double t = (double)(sample.time - now) / 1000 - meanT;
+        sxy += t * (sample.free - meanF);
+        sxx += t * t;
+    }
+    if (sxx <= 0)
+        return false;
+
+    slope = sxy / sxx;
+    return true;
+}
+
+bool MemoryForecaster::getSlope(double& slope)
+{
+    if (m_method == ForecastMethod_EWMA) {
+        if (!m_hasEwma)
+            return false;
+        slope = m_ewma;
+        return true;
+    }
+    return getRegressionSlope(slope);
+}
+
+long long MemoryForecaster::getTimeTo(long target)
+{
+    if (m_count == 0)
+        return -1;
+
+    const Sample& last = m_samples[(m_head + FORECAST_SAMPLE_COUNT - 1) % FORECAST_SAMPLE_COUNT];
+    if (last.free <= target)
+        return 0;
+
+    double slope;
+    if (!getSlope(slope) || slope >= 0)
+        return -1;
+    return (long long)((last.free - target) * 1000 / -slope);
+}
+
+void MemoryForecaster::print()
+{
+    double slope = 0;
+    getSlope(slope);
+    LOG_VERBOSE("METHOD(" + toString(m_method) + ") SAMPLES(" + to_string(m_count) + ") " +
+                "SLOPE(" + to_string(slope) + "MB/s)", LOG_NAME);
+}
+
+void MemoryForecaster::print(JValue& json)
+{
+    bool isValid;
+    long slope = getPrintedSlope(isValid);
+
+    json.put("method", toString(m_method));
+    json.put("samples", m_count);
+    json.put("valid", isValid);
+    // MB per second
+    json.put("slope", (double)slope / 10);
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MEMORYINFO_MEMORYFORECASTER_H_
+#define MEMORYINFO_MEMORYFORECASTER_H_
+
+#include <iostream>
+
+#include "base/IPrintable.h"
+
+#define FORECAST_SAMPLE_COUNT   64
+
+using namespace std;
+
+enum ForecastMethod {
+    ForecastMethod_Regression,
+    ForecastMethod_EWMA
+};
+
+// MemoryForecaster keeps timestamped MemAvailable samples and estimates how
+// fast available memory is changing. The slope is the least squares fit of
+// the samples in the window or the EWMA of slopes between samples.
+class MemoryForecaster : public IPrintable {
+public:
+    static string toString(enum ForecastMethod method);
+    static void toEnum(const string& str, enum ForecastMethod& method);
+
+    MemoryForecaster();
+    virtual ~MemoryForecaster();
+
+    // window (ms) : samples older than this are not used by the regression
+    // alpha (%) : weight of the latest slope in EWMA
+    void configure(enum ForecastMethod method, int window, int alpha);
+    void clear();
+
+    // 'free' (MB) at 'time' (ms, monotonic).
+    // Returns false if the sample is not newer than the latest one.
+    bool add(long long time, long free);
+
+    // MB per second. Negative while available memory is decreasing.
+    bool getSlope(double& slope);
+
+    // Milliseconds until available memory reaches 'target' (MB).
+    // Returns -1 if it is not decreasing.
+    long long getTimeTo(long target);
+
+    // Changed whenever a printed value is changed
+    unsigned long getGeneration()
+    {
+        return m_generation;
+    }
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    struct Sample {
+        long long time;
+        long free;
+    };
+
+    bool getRegressionSlope(double& slope);
+    // 0.1MB/s as printed. 0 if the slope is not valid.
+    long getPrintedSlope(bool& isValid);
+
+    Sample m_samples[FORECAST_SAMPLE_COUNT];
+    int m_head;
+    int m_count;
+
+    enum ForecastMethod m_method;
+    int m_window;
+    int m_alpha;
+
+    double m_ewma;
+    bool m_hasEwma;
+
+    long m_printedSlope;
+    bool m_printedValid;
+    unsigned long m_generation;
+};
+
+#endif /* MEMORYINFO_MEMORYFORECASTER_H_ */
@@ -16,12 +16,27 @@
 
 #include "MemoryInfoManager.h"
 
+#include <limits.h>
+#include <string.h>
+
 #include "setting/SettingManager.h"
 #include "util/Logger.h"
 #include "util/Proc.h"
+#include "util/Time.h"
 
 #define LOG_NAME    "ProcMeminfo"
 
+// The observed compression ratio is used after this much data is stored (KB)
+#define ZRAM_MIN_SAMPLE     (16 * 1024)
+
+// Forecasted times are printed in this resolution (ms)
+#define FORECAST_RESOLUTION 1000
+
+static long long roundTime(long long time)
+{
+    return (time < 0) ? -1 : time / FORECAST_RESOLUTION * FORECAST_RESOLUTION;
+}
+
 string MemoryInfoManager::toString(enum MemoryLevel level)
 {
     switch (level) {
@@ -42,7 +57,14 @@ MemoryInfoManager::MemoryInfoManager()
     : m_total(0)
     , m_free(0)
     , m_level(MemoryLevel_NORMAL)
+    , m_notifiedLevel(MemoryLevel_NORMAL)
+    , m_timeToCritical(-1)
+    , m_timeToLow(-1)
+    , m_earlyLowTime(0)
+    , m_generation(0)
 {
+    memset(&m_memInfo, -1, sizeof(m_memInfo));
+    memset(&m_swap, 0, sizeof(m_swap));
 }
 
 MemoryInfoManager::~MemoryInfoManager()
@@ -51,11 +73,135 @@ MemoryInfoManager::~MemoryInfoManager()
 
 void MemoryInfoManager::initialize(GMainLoop* mainloop)
 {
+    setupPressureMonitor();
+    setupForecaster();
+}
+
+void MemoryInfoManager::reload()
+{
+    // Thresholds are printed too
+    m_generation++;
+    setupPressureMonitor();
+    setupForecaster();
+    update(false);
+}
+
+void MemoryInfoManager::setupPressureMonitor()
+{
+    m_pressureMonitor.clear();
+    if (!SettingManager::getInstance().isPsiEnabled())
+        return;
+
+    int some = SettingManager::getInstance().getPsiSomeStall();
+    int full = SettingManager::getInstance().getPsiFullStall();
+    int window = SettingManager::getInstance().getPsiWindow();
+
+    m_pressureMonitor.setListener(this);
+    if (!m_pressureMonitor.addTrigger(PressureMonitor::PATH_SYSTEM, PressureType_Some, some, window) ||
+        !m_pressureMonitor.addTrigger(PressureMonitor::PATH_SYSTEM, PressureType_Full, full, window)) {
+        LOG_WARNING("PSI is not supported. Fallback to periodic tick", LOG_NAME);
+        m_pressureMonitor.clear();
+        return;
+    }
+
+    vector<string> cgroups = SettingManager::getInstance().getPsiCgroups();
+    for (auto it = cgroups.begin(); it != cgroups.end(); ++it) {
+        m_pressureMonitor.addTrigger(*it, PressureType_Some, some, window);
+    }
+}
+
+void MemoryInfoManager::setupForecaster()
+{
+    enum ForecastMethod method = ForecastMethod_Regression;
+    MemoryForecaster::toEnum(SettingManager::getInstance().getForecastMethod(), method);
+    m_forecaster.configure(method,
+                           SettingManager::getInstance().getForecastWindow(),
+                           SettingManager::getInstance().getForecastAlpha());
+    m_forecaster.clear();
+    m_timeToCritical = -1;
+    m_timeToLow = -1;
+}
+
+void MemoryInfoManager::forecast()
+{
+    if (!SettingManager::getInstance().isForecastEnabled())
+        return;
+
+    if (!m_forecaster.add(Time::getSystemTimeInMs(), m_free))
+        return;
+    long long prevTimeToCritical = roundTime(m_timeToCritical);
+    long long prevTimeToLow = roundTime(m_timeToLow);
+    m_timeToCritical = m_forecaster.getTimeTo(SettingManager::getInstance().getCriticalEnter());
+    m_timeToLow = m_forecaster.getTimeTo(SettingManager::getInstance().getLowEnter());
+
+    // The forecaster tracks its own printed values
+    if (roundTime(m_timeToCritical) != prevTimeToCritical || roundTime(m_timeToLow) != prevTimeToLow)
+        m_generation++;
+}
+
+void MemoryInfoManager::updateSwap()
+{
+    bool wasSaturated = m_swap.isSaturated;
+    memset(&m_swap, 0, sizeof(m_swap));
+    if (!SettingManager::getInstance().isSwapEnabled() || m_memInfo.swapTotal <= 0)
+        return;
+
+    int saturation = SettingManager::getInstance().getSwapSaturation();
+    long swapUsed = m_memInfo.swapTotal - m_memInfo.swapFree;
+    m_swap.ratio = SettingManager::getInstance().getSwapRatio();
+    m_swap.room = m_memInfo.swapFree;
+    m_swap.isSaturated = (swapUsed * 100 >= m_memInfo.swapTotal * saturation);
+
+    ZramSnapshot zram;
+    m_swap.isZram = Proc::getZramInfo(SettingManager::getInstance().getSwapDevice(), zram);
+    if (m_swap.isZram) {
+        // Metadata and fragmentation are included in 'mem_used_total'
+        if (zram.origDataSize >= ZRAM_MIN_SAMPLE && zram.memUsedTotal > 0) {
+            m_swap.ratio = (int)(zram.origDataSize * 100 / zram.memUsedTotal);
+            if (m_swap.ratio < SettingManager::getInstance().getSwapMinRatio())
+                m_swap.isSaturated = true;
+        }
+        if (zram.memLimit > 0) {
+            long limitRoom = (zram.memLimit - zram.memUsedTotal) * m_swap.ratio / 100;
+            if (limitRoom < m_swap.room)
+                m_swap.room = limitRoom;
+            if (zram.memUsedTotal * 100 >= zram.memLimit * saturation)
+                m_swap.isSaturated = true;
+        }
+    }
+
+    // Only anonymous memory goes to swap
+    long anon = m_memInfo.activeAnon + m_memInfo.inactiveAnon;
+    if (anon < m_swap.room)
+        m_swap.room = anon;
+    if (m_swap.room < 0)
+        m_swap.room = 0;
+
+    // Compressed pages still use memory in zram.
+    // Nothing is gained unless pages compress (the ratio can even be 0).
+    m_swap.gain = m_swap.room;
+    if (m_swap.isZram)
+        m_swap.gain = (m_swap.ratio > 100) ? m_swap.room - m_swap.room * 100 / m_swap.ratio : 0;
+    m_swap.gain = m_swap.gain * SettingManager::getInstance().getSwapWeight() / 100;
+    if (m_swap.isSaturated)
+        m_swap.gain = 0;
+
+    if (m_swap.isSaturated != wasSaturated) {
+        LOG_NORMAL(string("Swap is ") + (m_swap.isSaturated ? "saturated" : "available") +
+                   " - ratio(" + to_string(m_swap.ratio) + "%)", LOG_NAME);
+        m_generation++;
+    }
 }
 
 void MemoryInfoManager::update(bool disableCallback)
 {
-    Proc::getMemoryInfo(m_total, m_free);
+    if (!Proc::getMemoryInfo(m_memInfo))
+        return;
+    updateSwap();
+    long prevTotal = m_total;
+    long prevFree = m_free;
+    m_total = m_memInfo.memTotal / 1024;
+    m_free = (m_memInfo.memAvailable + m_swap.gain) / 1024;
 
     // update current level
     enum MemoryLevel prevLevel = m_level;
@@ -73,27 +219,46 @@ void MemoryInfoManager::update(bool disableCallback)
         m_level = MemoryLevel_NORMAL;
     }
 
+    if (m_total != prevTotal || m_free != prevFree || m_level != prevLevel)
+        m_generation++;
+    forecast();
+
     if (disableCallback || m_listener == nullptr)
         return;
 
     // notify level change
-    if (m_level != prevLevel) {
+    if (m_level != m_notifiedLevel) {
+        enum MemoryLevel notifiedLevel = m_notifiedLevel;
+        m_notifiedLevel = m_level;
         switch(m_level) {
         case MemoryLevel_NORMAL:
-            m_listener->onEnter(prevLevel, MemoryLevel_NORMAL);
+            m_listener->onEnter(notifiedLevel, MemoryLevel_NORMAL);
             break;
 
         case MemoryLevel_LOW:
-            m_listener->onEnter(prevLevel, MemoryLevel_LOW);
+            m_listener->onEnter(notifiedLevel, MemoryLevel_LOW);
             break;
 
         case MemoryLevel_CRITICAL:
-            m_listener->onEnter(prevLevel, MemoryLevel_CRITICAL);
+            m_listener->onEnter(notifiedLevel, MemoryLevel_CRITICAL);
             break;
         }
     }
 
     switch(m_level) {
+    case MemoryLevel_NORMAL:
+        // Reclaim before the kernel starts direct reclaim
+        if (m_timeToCritical >= 0 &&
+            m_timeToCritical < SettingManager::getInstance().getForecastHorizon()) {
+            long long now = Time::getSystemTimeInMs();
+            if (now - m_earlyLowTime >= SettingManager::getInstance().getKillInterval()) {
+                LOG_NORMAL("CRITICAL is expected in " + to_string(m_timeToCritical) + "ms", LOG_NAME);
+                m_earlyLowTime = now;
+                m_listener->onLow();
+            }
+        }
+        break;
+
     case MemoryLevel_LOW:
         m_listener->onLow();
         break;
@@ -107,6 +272,37 @@ void MemoryInfoManager::update(bool disableCallback)
     }
 }
 
+long long MemoryInfoManager::getTimeToCritical()
+{
+    return m_timeToCritical;
+}
+
+bool MemoryInfoManager::isSwapSaturated()
+{
+    return m_swap.isSaturated;
+}
+
+bool MemoryInfoManager::isEventDriven()
+{
+    return m_pressureMonitor.isAvailable();
+}
+
+void MemoryInfoManager::onPressure(const string& path, enum PressureType type)
+{
+    LOG_DEBUG("Pressure(" + PressureMonitor::toString(type) + ") - " + path, LOG_NAME);
+    update(false);
+}
+
+const MemInfoSnapshot& MemoryInfoManager::getMemInfo()
+{
+    return m_memInfo;
+}
+
+long MemoryInfoManager::getFree()
+{
+    return m_free;
+}
+
 enum MemoryLevel MemoryInfoManager::getCurrentLevel()
 {
     return m_level;
@@ -124,6 +320,14 @@ enum MemoryLevel MemoryInfoManager::getExpectedLevel(int memory)
         return MemoryLevel_NORMAL;
 }
 
+int MemoryInfoManager::getShortage(int memory)
+{
+    long long shortage = (long long)memory + SettingManager::getInstance().getCriticalEnter() - m_free;
+    if (shortage <= 0)
+        return 0;
+    return shortage < INT_MAX ? (int)shortage : INT_MAX;
+}
+
 void MemoryInfoManager::print()
 {
     // TODO
@@ -134,8 +338,21 @@ void MemoryInfoManager::print(JValue& json)
     current.put("level", toString(m_level));
     current.put("total", (int)m_total);
     current.put("free", (int)m_free);
+    current.put("available", (int)(m_memInfo.memAvailable / 1024));
     json.put("system", current);
 
+    if (m_memInfo.swapTotal > 0) {
+        // MB
+        JValue swap = pbnjson::Object();
+        swap.put("total", (int)(m_memInfo.swapTotal / 1024));
+        swap.put("free", (int)(m_memInfo.swapFree / 1024));
+        swap.put("zram", m_swap.isZram);
+        swap.put("ratio", m_swap.ratio);
+        swap.put("gain", (int)(m_swap.gain / 1024));
+        swap.put("saturated", m_swap.isSaturated);
+        json.put("swap", swap);
+    }
+
     JValue low = pbnjson::Object();
     low.put("enter", SettingManager::getInstance().getLowEnter());
     low.put("exit", SettingManager::getInstance().getLowExit());
@@ -147,5 +364,15 @@ void MemoryInfoManager::print(JValue& json)
     JValue threshold = pbnjson::Object();
     threshold.put("low", low);
     threshold.put("critical", critical);
+    SettingManager::getInstance().printThreshold(threshold);
+
+    if (SettingManager::getInstance().isForecastEnabled()) {
+        JValue forecast = pbnjson::Object();
+        m_forecaster.print(forecast);
+        forecast.put("timeToLow", (int64_t)roundTime(m_timeToLow));
+        forecast.put("timeToCritical", (int64_t)roundTime(m_timeToCritical));
+        forecast.put("horizon", SettingManager::getInstance().getForecastHorizon());
+        json.put("forecast", forecast);
+    }
     json.put("threshold", threshold);
 }
@@ -22,6 +22,9 @@
 
 #include "base/IManager.h"
 #include "base/IPrintable.h"
+#include "memoryinfo/MemoryForecaster.h"
+#include "memoryinfo/PressureMonitor.h"
+#include "util/MemInfo.h"
 
 using namespace std;
 
@@ -41,7 +44,9 @@ public :
     virtual void onCritical() = 0;
 };
 
-class MemoryInfoManager : public IManager<MemoryInfoManagerListener>, public IPrintable {
+class MemoryInfoManager : public IManager<MemoryInfoManagerListener>,
+                          public IPrintable,
+                          public PressureMonitorListener {
 public:
     static string toString(enum MemoryLevel level);
 
@@ -57,19 +62,74 @@ public:
 
     void update(bool disableCallback = true);
 
+    // Applies changed settings and re-evaluates the level
+    void reload();
+
+    const MemInfoSnapshot& getMemInfo();
+    // MB. MemAvailable and the effective gain of swap.
+    long getFree();
     enum MemoryLevel getCurrentLevel();
     enum MemoryLevel getExpectedLevel(int memory);
+    // MB to be reclaimed until 'memory' can be allocated without CRITICAL
+    int getShortage(int memory);
+
+    // Swap is (almost) full or does not compress. Paging out does not help.
+    bool isSwapSaturated();
+
+    // Returns true if level changes are reported by PSI triggers
+    bool isEventDriven();
+
+    // Milliseconds until CRITICAL at the current trend. -1 if not expected.
+    long long getTimeToCritical();
+
+    // Changed whenever a printed value is changed
+    unsigned long getGeneration()
+    {
+        return m_generation + m_forecaster.getGeneration();
+    }
+
+    // PressureMonitorListener
+    virtual void onPressure(const string& path, enum PressureType type);
 
     virtual void print();
     virtual void print(JValue& json);
 
 private:
+    // KB
+    struct SwapState {
+        bool isZram;
+        // Observed compression ratio (%)
+        int ratio;
+        long room;
+        long gain;
+        bool isSaturated;
+    };
+
     MemoryInfoManager();
 
+    void updateSwap();
+
+    void setupPressureMonitor();
+    void setupForecaster();
+    void forecast();
+
+    PressureMonitor m_pressureMonitor;
+
+    MemInfoSnapshot m_memInfo;
+    SwapState m_swap;
     long m_total;
     long m_free;
     enum MemoryLevel m_level;
+    // The level which the listener was told about. Updates without
+    // callbacks can change 'm_level', so the next one reports it.
+    enum MemoryLevel m_notifiedLevel;
+
+    MemoryForecaster m_forecaster;
+    long long m_timeToCritical;
+    long long m_timeToLow;
+    long long m_earlyLowTime;
 
+    unsigned long m_generation;
 };
 
 #endif /* MEMORYINFO_MEMORYINFOMANAGER_H_ */
@@ -0,0 +1,122 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PressureMonitor.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <glib-unix.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "util/Logger.h"
+
+#define LOG_NAME    "PressureMonitor"
+
+const string PressureMonitor::PATH_SYSTEM = "/proc/pressure/memory";
+
+string PressureMonitor::toString(enum PressureType type)
+{
+    switch (type) {
+    case PressureType_Some:
+        return "some";
+
+    case PressureType_Full:
+        return "full";
+    }
+    return "unknown";
+}
+
+gboolean PressureMonitor::_onEvent(gint fd, GIOCondition condition, gpointer user_data)
+{
+    Trigger* trigger = (Trigger*)user_data;
+    PressureMonitor* monitor = trigger->monitor;
+
+    if (condition & (G_IO_ERR | G_IO_HUP | G_IO_NVAL)) {
+        // cgroup is removed or the kernel dropped the trigger
+        LOG_WARNING("Trigger is closed - " + trigger->path, LOG_NAME);
+        trigger->src = 0;
+        monitor->removeTrigger(trigger);
+        return G_SOURCE_REMOVE;
+    }
+
+    if (monitor->m_listener)
+        monitor->m_listener->onPressure(trigger->path, trigger->type);
+    return G_SOURCE_CONTINUE;
+}
+
+PressureMonitor::PressureMonitor()
+    : m_listener(nullptr)
+{
+}
+
+PressureMonitor::~PressureMonitor()
+{
+    clear();
+}
+
+bool PressureMonitor::addTrigger(const string& path, enum PressureType type, int stall, int window)
+{
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARNING("Failed to open " + path + " - " + strerror(errno), LOG_NAME);
+        return false;
+    }
+
+    // PSI expects microseconds and the terminating null character
+    string command = toString(type) + " " + to_string(stall * 1000) + " " + to_string(window * 1000);
+    if (write(fd, command.c_str(), command.size() + 1) < 0) {
+        LOG_WARNING("Failed to register trigger '" + command + "' on " + path + " - " + strerror(errno), LOG_NAME);
+        close(fd);
+        return false;
+    }
+
+    Trigger* trigger = new Trigger();
+    trigger->monitor = this;
+    trigger->path = path;
+    trigger->type = type;
+    trigger->fd = fd;
+    trigger->src = g_unix_fd_add(fd, (GIOCondition)(G_IO_PRI | G_IO_ERR | G_IO_HUP), _onEvent, trigger);
+    m_triggers.push_back(trigger);
+
+    LOG_NORMAL("Trigger is registered '" + command + "' on " + path, LOG_NAME);
+    return true;
+}
+
+void PressureMonitor::removeTrigger(Trigger* trigger)
+{
+    auto it = std::find(m_triggers.begin(), m_triggers.end(), trigger);
+    if (it != m_triggers.end())
+        m_triggers.erase(it);
+
+    if (trigger->src > 0)
+        g_source_remove(trigger->src);
+    close(trigger->fd);
+    delete trigger;
+}
+
+void PressureMonitor::clear()
+{
+    while (!m_triggers.empty()) {
+        removeTrigger(m_triggers.back());
+    }
+}
+
+bool PressureMonitor::isAvailable()
+{
+    return !m_triggers.empty();
+}
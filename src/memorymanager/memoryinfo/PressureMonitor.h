@@ -0,0 +1,77 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MEMORYINFO_PRESSUREMONITOR_H_
+#define MEMORYINFO_PRESSUREMONITOR_H_
+
+#include <iostream>
+#include <vector>
+#include <glib.h>
+
+using namespace std;
+
+enum PressureType {
+    PressureType_Some,
+    PressureType_Full
+};
+
+class PressureMonitorListener {
+public:
+    PressureMonitorListener() {};
+    virtual ~PressureMonitorListener() {};
+
+    virtual void onPressure(const string& path, enum PressureType type) = 0;
+};
+
+// PressureMonitor registers PSI triggers on '/proc/pressure/memory' or
+// cgroup 'memory.pressure' files and reports them through the main loop.
+class PressureMonitor {
+public:
+    static const string PATH_SYSTEM;
+    static string toString(enum PressureType type);
+
+    PressureMonitor();
+    virtual ~PressureMonitor();
+
+    // stall and window are milliseconds
+    bool addTrigger(const string& path, enum PressureType type, int stall, int window);
+    void clear();
+
+    bool isAvailable();
+
+    void setListener(PressureMonitorListener* listener)
+    {
+        m_listener = listener;
+    }
+
+private:
+    struct Trigger {
+        PressureMonitor* monitor;
+        string path;
+        enum PressureType type;
+        int fd;
+        guint src;
+    };
+
+    static gboolean _onEvent(gint fd, GIOCondition condition, gpointer user_data);
+
+    void removeTrigger(Trigger* trigger);
+
+    vector<Trigger*> m_triggers;
+    PressureMonitorListener* m_listener;
+};
+
+#endif /* MEMORYINFO_PRESSUREMONITOR_H_ */
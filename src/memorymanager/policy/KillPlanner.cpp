@@ -0,0 +1,162 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "KillPlanner.h"
+
+#include <stdint.h>
+
+#include "util/Logger.h"
+
+#define LOG_NAME    "KillPlanner"
+
+// Killing the foreground application is the last resort
+#define COST_FOREGROUND    100000
+
+KillPlan::KillPlan()
+    : requiredMemory(0)
+    , reclaimable(0)
+    , closing(0)
+    , isSatisfied(false)
+{
+}
+
+KillPlan::~KillPlan()
+{
+}
+
+void KillPlan::print()
+{
+    string msg = "REQUIRED(" + to_string(requiredMemory) + "MB) ";
+    msg += "CLOSING(" + to_string(closing) + "MB) ";
+    msg += "RECLAIMABLE(" + to_string(reclaimable) + "MB) ";
+    msg += "SATISFIED(" + string(isSatisfied ? "true" : "false") + ") VICTIMS(";
+    for (auto it = victims.begin(); it != victims.end(); ++it) {
+        msg += (it == victims.begin() ? "" : " ") + *it;
+    }
+    msg += ")";
+    LOG_NORMAL(msg, LOG_NAME);
+}
+
+void KillPlan::print(JValue& json)
+{
+    json.put("requiredMemory", requiredMemory);
+    json.put("reclaimable", reclaimable);
+    json.put("closing", closing);
+    json.put("satisfied", isSatisfied);
+
+    JValue array = pbnjson::Array();
+    for (auto it = victims.begin(); it != victims.end(); ++it) {
+        array.append(*it);
+    }
+    json.put("victims", array);
+}
+
+bool KillPlanner::planLowest(vector<Application*>& candidates, vector<int>& sizes, KillPlan& plan)
+{
+    // Reclaimable memory is unknown or not enough. Close the lowest
+    // priority application and plan again with the result.
+    plan.victims.push_back(candidates[0]->getAppId());
+    plan.reclaimable = sizes[0];
+    return true;
+}
+
+bool KillPlanner::plan(ApplicationRegistry& applications, int requiredMemory, bool includeForeground, KillPlan& plan)
+{
+    plan = KillPlan();
+    plan.requiredMemory = requiredMemory;
+
+    // Memory of closing applications is coming back soon
+    vector<Application*> candidates;
+    int closing = 0;
+    for (auto it = applications.rbegin(); it != applications.rend(); ++it) {
+        Application& application = **it;
+        if (application.isClosing()) {
+            closing += application.getReclaimable() / 1024;
+            continue;
+        }
+        if (!includeForeground && application.getApplicationStatus() == ApplicationStatus_Foreground)
+            continue;
+        candidates.push_back(&application);
+    }
+    plan.closing = closing;
+
+    int required = requiredMemory - closing;
+    if (required <= 0) {
+        plan.isSatisfied = true;
+        return true;
+    }
+    if (candidates.empty())
+        return false;
+
+    // 0/1 knapsack covering 'required' MB with the minimum cost.
+    // candidates[0] is the lowest priority one and costs 1. The cost grows
+    // quadratically, so that two low priority applications are preferred
+    // to a single application with much higher priority.
+    size_t count = candidates.size();
+    vector<int64_t> costs(count);
+    vector<int> sizes(count);
+    long long total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Application& application = *candidates[i];
+        costs[i] = (int64_t)(i + 1) * (i + 1);
+        if (application.getApplicationStatus() == ApplicationStatus_Foreground)
+            costs[i] += COST_FOREGROUND;
+        sizes[i] = application.getReclaimable() / 1024;
+        if (sizes[i] > 0)
+            total += sizes[i];
+    }
+
+    // The tables below grow with 'required'. Do not build them if all
+    // candidates together can not cover it.
+    if (required > total)
+        return planLowest(candidates, sizes, plan);
+
+    // best[m] : minimum (cost, victims) to reclaim at least m MB.
+    // Sums exceed 32 bits with hundreds of candidates.
+    vector<int64_t> best(required + 1, INT64_MAX);
+    vector<vector<bool>> taken(count, vector<bool>(required + 1, false));
+    best[0] = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (sizes[i] <= 0)
+            continue;
+        // Fewer victims win on the same cost
+        int64_t value = costs[i] * (int64_t)(count + 1) + 1;
+        for (int m = required; m > 0; --m) {
+            int prev = m > sizes[i] ? m - sizes[i] : 0;
+            if (best[prev] == INT64_MAX)
+                continue;
+            if (best[prev] + value < best[m]) {
+                best[m] = best[prev] + value;
+                taken[i][m] = true;
+            }
+        }
+    }
+
+    if (best[required] == INT64_MAX)
+        return planLowest(candidates, sizes, plan);
+
+    int m = required;
+    for (int i = count - 1; i >= 0 && m > 0; --i) {
+        if (!taken[i][m])
+            continue;
+        Application& application = *candidates[i];
+        plan.victims.push_back(application.getAppId());
+        plan.reclaimable += sizes[i];
+        m = m > sizes[i] ? m - sizes[i] : 0;
+    }
+    plan.isSatisfied = true;
+    return true;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef POLICY_KILLPLANNER_H_
+#define POLICY_KILLPLANNER_H_
+
+#include <iostream>
+#include <vector>
+
+#include "base/Application.h"
+#include "base/ApplicationRegistry.h"
+#include "base/IPrintable.h"
+
+using namespace std;
+
+class KillPlan : public IPrintable {
+public:
+    KillPlan();
+    virtual ~KillPlan();
+
+    // MB
+    int requiredMemory;
+    int reclaimable;
+    int closing;
+    bool isSatisfied;
+
+    vector<string> victims;
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+};
+
+// Chooses the cheapest set of applications whose reclaimable memory covers
+// the required memory. The cost of a victim grows with its priority in
+// 'Application::compare' order, and a foreground application is only chosen
+// if 'includeForeground' is set.
+class KillPlanner {
+public:
+    static bool plan(ApplicationRegistry& applications, int requiredMemory, bool includeForeground, KillPlan& plan);
+
+private:
+    static bool planLowest(vector<Application*>& candidates, vector<int>& sizes, KillPlan& plan);
+
+    KillPlanner() {}
+    virtual ~KillPlanner() {}
+};
+
+#endif /* POLICY_KILLPLANNER_H_ */
@@ -0,0 +1,144 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MemoryPolicy.h"
+
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+#define LOG_NAME    "MemoryPolicy"
+
+MemoryPolicy::MemoryPolicy()
+    : m_lastKillTime(0)
+{
+}
+
+MemoryPolicy::~MemoryPolicy()
+{
+}
+
+void MemoryPolicy::initialize(GMainLoop* mainloop)
+{
+}
+
+void MemoryPolicy::onLow()
+{
+    if (!m_listener)
+        return;
+
+    // Preloaded applications go first as a group
+    if (m_listener->onEvictPreloads())
+        return;
+    // Background applications are kept alive in swap as long as possible
+    if (m_listener->onReclaimSwap())
+        return;
+    // Then they release memory by themselves
+    if (m_listener->onTrim(MemoryLevel_LOW))
+        return;
+    m_listener->onCloseApp(false);
+}
+
+void MemoryPolicy::onCritical()
+{
+    if (!m_listener)
+        return;
+
+    if (m_listener->onEvictPreloads())
+        return;
+    if (m_listener->onTrim(MemoryLevel_CRITICAL))
+        return;
+    m_listener->onCloseApp(true);
+}
+
+void MemoryPolicy::requireMemory(unsigned long id, int requiredMemory)
+{
+    MemoryInfoManager::getInstance().update();
+
+    RequireMemoryRequest item;
+    item.id = id;
+    item.requiredMemory = requiredMemory;
+    item.retry = 0;
+    item.startFree = MemoryInfoManager::getInstance().getFree();
+    item.reclaimed = 0;
+    m_requests.push_back(item);
+
+    reclaim();
+}
+
+void MemoryPolicy::reclaim()
+{
+    if (!m_listener)
+        return;
+
+    MemoryInfoManager::getInstance().update();
+
+    long long now = Time::getSystemTimeInMs();
+    bool killable = (now - m_lastKillTime >= SettingManager::getInstance().getKillInterval());
+    bool killed = false;
+
+    auto it = m_requests.begin();
+    while (it != m_requests.end()) {
+        if (MemoryInfoManager::getInstance().getExpectedLevel(it->requiredMemory) != MemoryLevel_CRITICAL) {
+            reply(*it, true, "");
+            it = m_requests.erase(it);
+            continue;
+        }
+
+        int reclaimed = MemoryInfoManager::getInstance().getFree() - it->startFree;
+        if (reclaimed > it->reclaimed) {
+            it->reclaimed = reclaimed;
+            m_listener->onRequireMemoryProgress(it->id, it->requiredMemory, it->reclaimed);
+        }
+
+        if (!killable) {
+            ++it;
+            continue;
+        }
+
+        if (it->retry >= SettingManager::getInstance().getRetryCount()) {
+            reply(*it, false, "Failed to reclaim required memory. Timeout.");
+            it = m_requests.erase(it);
+            continue;
+        }
+        if (m_listener->getRunningAppCount() == 0) {
+            reply(*it, false, "Failed to reclaim required memory. All apps were closed");
+            it = m_requests.erase(it);
+            continue;
+        }
+
+        // A single kill serves all pending requests
+        if (!killed) {
+            m_listener->onUpdateMemory();
+            m_listener->onCloseApp(true, MemoryInfoManager::getInstance().getShortage(it->requiredMemory));
+            m_lastKillTime = now;
+            killed = true;
+        }
+        it->retry++;
+        ++it;
+    }
+}
+
+bool MemoryPolicy::hasRequests()
+{
+    return !m_requests.empty();
+}
+
+void MemoryPolicy::reply(RequireMemoryRequest& request, bool returnValue, const string& errorText)
+{
+    int reclaimed = MemoryInfoManager::getInstance().getFree() - request.startFree;
+    m_listener->onRequireMemoryReply(request.id, returnValue, errorText, reclaimed > 0 ? reclaimed : 0);
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef POLICY_MEMORYPOLICY_H_
+#define POLICY_MEMORYPOLICY_H_
+
+#include <iostream>
+#include <list>
+
+#include "base/IManager.h"
+#include "memoryinfo/MemoryInfoManager.h"
+
+using namespace std;
+
+// Actions of the policy. memorymanager runs them with the managers and
+// memorymanager-sim runs them against the replayed trace.
+class MemoryPolicyListener {
+public:
+    MemoryPolicyListener() {};
+    virtual ~MemoryPolicyListener() {};
+
+    // Each action returns true if it released (or will release) memory
+    virtual bool onEvictPreloads() = 0;
+    virtual bool onReclaimSwap() = 0;
+    virtual bool onTrim(enum MemoryLevel level) = 0;
+    virtual bool onCloseApp(bool includeForeground, int requiredMemory = 0) = 0;
+
+    // Refreshes the memory usage of applications before planning kills
+    virtual void onUpdateMemory() = 0;
+    virtual int getRunningAppCount() = 0;
+
+    // 'id' is the one given to 'MemoryPolicy::requireMemory'
+    virtual void onRequireMemoryProgress(unsigned long id, int requiredMemory, int reclaimed) = 0;
+    virtual void onRequireMemoryReply(unsigned long id, bool returnValue, const string& errorText, int reclaimed) = 0;
+};
+
+// Decides what to do on each memory level and for requireMemory requests.
+// It depends only on MemoryInfoManager and SettingManager, so that the
+// daemon and the simulator run the same decisions.
+class MemoryPolicy : public IManager<MemoryPolicyListener> {
+public:
+    MemoryPolicy();
+    virtual ~MemoryPolicy();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    void onLow();
+    void onCritical();
+
+    // The reply can be sent before this returns
+    void requireMemory(unsigned long id, int requiredMemory);
+
+    // Retries pending requests. Call it periodically while 'hasRequests'.
+    void reclaim();
+    bool hasRequests();
+
+private:
+    struct RequireMemoryRequest {
+        unsigned long id;
+        int requiredMemory;
+        int retry;
+        long startFree;
+        int reclaimed;
+    };
+
+    void reply(RequireMemoryRequest& request, bool returnValue, const string& errorText);
+
+    list<RequireMemoryRequest> m_requests;
+    long long m_lastKillTime;
+
+};
+
+#endif /* POLICY_MEMORYPOLICY_H_ */
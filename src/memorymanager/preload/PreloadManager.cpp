@@ -0,0 +1,173 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PreloadManager.h"
+
+#include <vector>
+
+#include "luna/client/ApplicationManager.h"
+#include "memoryinfo/MemoryInfoManager.h"
+#include "profile/ProfileManager.h"
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+#define LOG_NAME            "PreloadManager"
+
+// An evicted application is not preloaded again for this long (ms).
+// Otherwise preload and eviction can repeat while the memory stays tight.
+#define EVICT_BACKOFF       600000
+
+PreloadManager::PreloadManager()
+    : m_preloadTime(0)
+    , m_preloads(0)
+    , m_evictions(0)
+    , m_generation(0)
+{
+}
+
+PreloadManager::~PreloadManager()
+{
+}
+
+void PreloadManager::initialize(GMainLoop* mainloop)
+{
+}
+
+void PreloadManager::update()
+{
+    if (!SettingManager::getInstance().isPreloadEnabled())
+        return;
+
+    int count = 0;
+    long usage = getUsage(count);
+    long budget = getBudget();
+    if (usage > budget || MemoryInfoManager::getInstance().getCurrentLevel() != MemoryLevel_NORMAL) {
+        if (count > 0) {
+            LOG_NORMAL("Preloaded applications use " + to_string(usage) + "MB of " + to_string(budget) + "MB", LOG_NAME);
+            evict();
+        }
+        return;
+    }
+
+    if (count >= SettingManager::getInstance().getPreloadMaxCount())
+        return;
+    long long now = Time::getSystemTimeInMs();
+    if (m_preloadTime > 0 && now - m_preloadTime < SettingManager::getInstance().getPreloadInterval())
+        return;
+
+    auto evicted = m_evicted.begin();
+    while (evicted != m_evicted.end()) {
+        if (now - evicted->second >= EVICT_BACKOFF)
+            evicted = m_evicted.erase(evicted);
+        else
+            ++evicted;
+    }
+
+    vector<string> candidates;
+    ProfileManager::getInstance().getLikelyLaunches(candidates);
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        if (applications.isExist(*it) || m_evicted.find(*it) != m_evicted.end())
+            continue;
+
+        int required = ProfileManager::getInstance().getRequiredMemory(*it, 0);
+        if (required <= 0 || usage + required > budget)
+            continue;
+        // Preloading must not take the level out of NORMAL
+        if (MemoryInfoManager::getInstance().getFree() - required < SettingManager::getInstance().getLowExit())
+            continue;
+
+        if (!ApplicationManager::getInstance().preload(*it))
+            return;
+        LOG_NORMAL("Preload - " + *it + " required(" + to_string(required) + "MB)", LOG_NAME);
+        m_preloadTime = now;
+        m_lastPreload = *it;
+        m_preloads++;
+        m_generation++;
+        return;
+    }
+}
+
+bool PreloadManager::evict()
+{
+    if (!SettingManager::getInstance().isPreloadEnabled())
+        return false;
+
+    vector<string> appIds;
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = applications.begin(); it != applications.end(); ++it) {
+        if ((*it)->getApplicationStatus() == ApplicationStatus_Preload && !(*it)->isClosing())
+            appIds.push_back((*it)->getAppId());
+    }
+
+    long long now = Time::getSystemTimeInMs();
+    for (auto it = appIds.begin(); it != appIds.end(); ++it) {
+        LOG_NORMAL("Evict preloaded application - " + *it, LOG_NAME);
+        ApplicationManager::getInstance().close(*it);
+        m_evicted[*it] = now;
+    }
+    if (appIds.empty())
+        return false;
+
+    m_evictions += appIds.size();
+    m_generation++;
+    return true;
+}
+
+long PreloadManager::getBudget()
+{
+    long total = MemoryInfoManager::getInstance().getMemInfo().memTotal / 1024;
+    return total * SettingManager::getInstance().getPreloadBudget() / 100;
+}
+
+long PreloadManager::getUsage(int& count)
+{
+    long usage = 0;
+    count = 0;
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = applications.begin(); it != applications.end(); ++it) {
+        if ((*it)->getApplicationStatus() != ApplicationStatus_Preload)
+            continue;
+        usage += (*it)->getProcessGroup().getPss() / 1024;
+        count++;
+    }
+    return usage;
+}
+
+void PreloadManager::print()
+{
+    int count = 0;
+    long usage = getUsage(count);
+    LOG_VERBOSE("COUNT(" + to_string(count) + ") USED(" + to_string(usage) + "MB) BUDGET(" + to_string(getBudget()) + "MB) " +
+                "PRELOADS(" + to_string(m_preloads) + ") EVICTIONS(" + to_string(m_evictions) + ")", LOG_NAME);
+}
+
+void PreloadManager::print(JValue& json)
+{
+    int count = 0;
+    long usage = getUsage(count);
+
+    // MB
+    JValue preload = pbnjson::Object();
+    preload.put("budget", (int)getBudget());
+    preload.put("used", (int)usage);
+    preload.put("count", count);
+    preload.put("lastPreloaded", m_lastPreload);
+    preload.put("preloads", m_preloads);
+    preload.put("evictions", m_evictions);
+    json.put("preload", preload);
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PRELOAD_PRELOADMANAGER_H_
+#define PRELOAD_PRELOADMANAGER_H_
+
+#include <iostream>
+#include <map>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "base/IManager.h"
+#include "base/IPrintable.h"
+
+using namespace std;
+using namespace pbnjson;
+
+class PreloadManagerListener {
+public:
+    PreloadManagerListener() {};
+    virtual ~PreloadManagerListener() {};
+
+};
+
+// Keeps the applications which are likely launched next preloaded within
+// a share of memory. Preloaded applications are evicted as a group before
+// any other application when the budget or the level requires it.
+class PreloadManager : public IManager<PreloadManagerListener>,
+                       public IPrintable {
+public:
+    static PreloadManager& getInstance()
+    {
+        static PreloadManager s_instance;
+        return s_instance;
+    }
+
+    virtual ~PreloadManager();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    // Evicts preloaded applications over the budget or preloads the next
+    // likely launched one if there is headroom
+    void update();
+    // Closes all preloaded applications. Returns true if any is closed.
+    bool evict();
+
+    // Changed whenever printed values are changed
+    unsigned long getGeneration()
+    {
+        return m_generation;
+    }
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    PreloadManager();
+
+    // MB
+    long getBudget();
+    long getUsage(int& count);
+
+    long long m_preloadTime;
+    string m_lastPreload;
+    // Eviction time (ms) by appId
+    map<string, long long> m_evicted;
+    int m_preloads;
+    int m_evictions;
+
+    unsigned long m_generation;
+};
+
+#endif /* PRELOAD_PRELOADMANAGER_H_ */
@@ -0,0 +1,255 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ProfileManager.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <fstream>
+#include <libgen.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+#define LOG_NAME            "ProfileManager"
+
+#define PROFILE_HEADER      "# memorymanager footprint v1"
+
+// Profiles are written after changes settle
+#define SAVE_DELAY          10
+
+gboolean ProfileManager::_save(gpointer user_data)
+{
+    ProfileManager* self = (ProfileManager*)user_data;
+    self->m_saveSrc = 0;
+    self->save();
+    return G_SOURCE_REMOVE;
+}
+
+ProfileManager::ProfileManager()
+    : m_saveSrc(0)
+{
+}
+
+ProfileManager::~ProfileManager()
+{
+    if (m_saveSrc > 0) {
+        g_source_remove(m_saveSrc);
+        save();
+    }
+}
+
+void ProfileManager::initialize(GMainLoop* mainloop)
+{
+    if (!SettingManager::getInstance().isProfileEnabled())
+        return;
+    load();
+}
+
+void ProfileManager::record(Application& application)
+{
+    if (!SettingManager::getInstance().isProfileEnabled())
+        return;
+
+    // A preloaded application is not launched by the user, and its
+    // footprint is smaller. The session starts when it is launched.
+    if (application.getApplicationStatus() == ApplicationStatus_Preload)
+        return;
+
+    long pss = application.getProcessGroup().getPss() / 1024;
+    if (pss <= 0)
+        return;
+
+    long long now = Time::getSystemTimeInMs();
+    auto it = m_sessions.find(application.getAppId());
+    if (it == m_sessions.end()) {
+        Session session;
+        session.startTime = now;
+        session.peak = 0;
+        session.steady = 0;
+        it = m_sessions.insert(make_pair(application.getAppId(), session)).first;
+    }
+
+    Session& session = it->second;
+    if (pss > session.peak)
+        session.peak = pss;
+
+    // Usage after the launch phase is the steady state
+    if (now - session.startTime >= SettingManager::getInstance().getProfileLaunchPeriod() * 1000) {
+        if (session.steady == 0)
+            session.steady = pss;
+        else
+            session.steady = (session.steady * 3 + pss) / 4;
+    }
+}
+
+void ProfileManager::finish(const string& appId)
+{
+    auto it = m_sessions.find(appId);
+    if (it == m_sessions.end())
+        return;
+
+    Session session = it->second;
+    m_sessions.erase(it);
+    if (session.peak <= 0)
+        return;
+
+    auto profile = m_profiles.find(appId);
+    if (profile == m_profiles.end()) {
+        Profile item;
+        item.peak = session.peak;
+        item.steady = session.steady;
+        item.launches = 0;
+        profile = m_profiles.insert(make_pair(appId, item)).first;
+    } else {
+        // A recent peak counts more. A higher one is adopted faster.
+        if (session.peak > profile->second.peak)
+            profile->second.peak = (profile->second.peak + session.peak) / 2;
+        else
+            profile->second.peak = (profile->second.peak * 3 + session.peak) / 4;
+        if (session.steady > 0)
+            profile->second.steady = (profile->second.steady * 3 + session.steady) / 4;
+    }
+    profile->second.launches++;
+    profile->second.lastUsed = time(NULL);
+
+    LOG_VERBOSE("PEAK(" + to_string(profile->second.peak) + "MB) " +
+                "STEADY(" + to_string(profile->second.steady) + "MB) " +
+                "LAUNCHES(" + to_string(profile->second.launches) + ")", appId);
+
+    evict();
+    if (m_saveSrc == 0)
+        m_saveSrc = g_timeout_add_seconds(SAVE_DELAY, _save, this);
+}
+
+int ProfileManager::getRequiredMemory(const string& appId, int defaultMemory)
+{
+    if (!SettingManager::getInstance().isProfileEnabled())
+        return defaultMemory;
+
+    auto it = m_profiles.find(appId);
+    if (it == m_profiles.end() || it->second.launches < SettingManager::getInstance().getProfileMinLaunches())
+        return defaultMemory;
+
+    // Launching needs the peak. Some margin is added for the variation.
+    long required = it->second.peak * (100 + SettingManager::getInstance().getProfileMargin()) / 100;
+    return required > 0 ? (int)required : defaultMemory;
+}
+
+void ProfileManager::getLikelyLaunches(vector<string>& appIds)
+{
+    appIds.clear();
+    if (!SettingManager::getInstance().isProfileEnabled())
+        return;
+
+    // Launches are weighted down by the hours since the last use
+    long now = (long)time(NULL);
+    vector<pair<double, string>> scores;
+    for (auto it = m_profiles.begin(); it != m_profiles.end(); ++it) {
+        if (it->second.launches < SettingManager::getInstance().getProfileMinLaunches())
+            continue;
+        long age = now - it->second.lastUsed;
+        if (age < 0)
+            age = 0;
+        double score = it->second.launches * 3600.0 / (3600.0 + age);
+        scores.push_back(make_pair(score, it->first));
+    }
+    sort(scores.begin(), scores.end(), [] (const pair<double, string>& a, const pair<double, string>& b) {
+        return a.first > b.first;
+    });
+    for (auto it = scores.begin(); it != scores.end(); ++it) {
+        appIds.push_back(it->second);
+    }
+}
+
+bool ProfileManager::load()
+{
+    string path = SettingManager::getInstance().getProfilePath();
+    ifstream file(path.c_str());
+    if (!file.is_open())
+        return false;
+
+    string line;
+    if (!getline(file, line) || line != PROFILE_HEADER) {
+        LOG_WARNING("Unknown profile format - " + path, LOG_NAME);
+        return false;
+    }
+
+    m_profiles.clear();
+    char appId[256];
+    Profile profile;
+    while (getline(file, line)) {
+        if (sscanf(line.c_str(), "%255s %ld %ld %d %ld", appId, &profile.peak, &profile.steady,
+                   &profile.launches, &profile.lastUsed) != 5)
+            continue;
+        m_profiles[appId] = profile;
+    }
+    LOG_NORMAL("Loaded " + to_string(m_profiles.size()) + " profiles - " + path, LOG_NAME);
+    return true;
+}
+
+bool ProfileManager::save()
+{
+    string path = SettingManager::getInstance().getProfilePath();
+    string temp = path + ".tmp";
+
+    char dir[PATH_MAX];
+    strncpy(dir, path.c_str(), sizeof(dir) - 1);
+    dir[sizeof(dir) - 1] = '\0';
+    mkdir(dirname(dir), 0755);
+
+    // The previous database is kept until the new one is complete
+    FILE* fp = fopen(temp.c_str(), "w");
+    if (fp == NULL) {
+        LOG_WARNING("Failed to open " + temp + " - " + strerror(errno), LOG_NAME);
+        return false;
+    }
+    fprintf(fp, "%s\n", PROFILE_HEADER);
+    for (auto it = m_profiles.begin(); it != m_profiles.end(); ++it) {
+        fprintf(fp, "%s %ld %ld %d %ld\n", it->first.c_str(), it->second.peak, it->second.steady,
+                it->second.launches, it->second.lastUsed);
+    }
+    bool result = (fflush(fp) == 0 && fsync(fileno(fp)) == 0);
+    fclose(fp);
+
+    if (!result || rename(temp.c_str(), path.c_str()) != 0) {
+        LOG_WARNING("Failed to save " + path + " - " + strerror(errno), LOG_NAME);
+        unlink(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+void ProfileManager::evict()
+{
+    // The least recently used profiles are removed first
+    size_t max = SettingManager::getInstance().getProfileMaxCount();
+    while (m_profiles.size() > max) {
+        auto oldest = m_profiles.begin();
+        for (auto it = m_profiles.begin(); it != m_profiles.end(); ++it) {
+            if (it->second.lastUsed < oldest->second.lastUsed)
+                oldest = it;
+        }
+        m_profiles.erase(oldest);
+    }
+}
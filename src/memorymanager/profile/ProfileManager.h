@@ -0,0 +1,97 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PROFILE_PROFILEMANAGER_H_
+#define PROFILE_PROFILEMANAGER_H_
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <glib.h>
+
+#include "base/Application.h"
+#include "base/IManager.h"
+
+using namespace std;
+
+class ProfileManagerListener {
+public:
+    ProfileManagerListener() {};
+    virtual ~ProfileManagerListener() {};
+
+};
+
+// Learns the memory footprint of each application from its samples and
+// keeps it in a small on-disk database. It is used to size 'requireMemory'
+// requests which do not specify the required memory.
+class ProfileManager : public IManager<ProfileManagerListener> {
+public:
+    static ProfileManager& getInstance()
+    {
+        static ProfileManager s_instance;
+        return s_instance;
+    }
+
+    virtual ~ProfileManager();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    // Called with each memory sample of the application.
+    // Samples while the application is only preloaded are ignored.
+    void record(Application& application);
+    // The application is terminated. Its session is merged into the profile.
+    void finish(const string& appId);
+
+    // MB. Returns 'defaultMemory' if the application is not learned yet.
+    int getRequiredMemory(const string& appId, int defaultMemory);
+
+    // Learned applications which are most likely to be launched next.
+    // Frequently and recently launched ones come first.
+    void getLikelyLaunches(vector<string>& appIds);
+
+    bool load();
+    bool save();
+
+private:
+    struct Profile {
+        // MB
+        long peak;
+        long steady;
+        int launches;
+        // seconds since epoch
+        long lastUsed;
+    };
+
+    struct Session {
+        long long startTime;
+        long peak;
+        long steady;
+    };
+
+    static gboolean _save(gpointer user_data);
+
+    ProfileManager();
+
+    void evict();
+
+    map<string, Profile> m_profiles;
+    map<string, Session> m_sessions;
+
+    guint m_saveSrc;
+};
+
+#endif /* PROFILE_PROFILEMANAGER_H_ */
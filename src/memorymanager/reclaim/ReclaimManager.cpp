@@ -0,0 +1,269 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReclaimManager.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+#include "luna/client/ApplicationManager.h"
+#include "memoryinfo/MemoryInfoManager.h"
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/PidFd.h"
+#include "util/Proc.h"
+#include "util/Time.h"
+
+#define LOG_NAME            "ReclaimManager"
+
+// Linux 5.4
+#ifndef MADV_COLD
+#define MADV_COLD           20
+#endif
+#ifndef MADV_PAGEOUT
+#define MADV_PAGEOUT        21
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX             1024
+#endif
+
+string ReclaimManager::toString(enum ReclaimMethod method)
+{
+    switch (method) {
+    case ReclaimMethod_None:
+        return "none";
+
+    case ReclaimMethod_Cgroup:
+        return "cgroup";
+
+    case ReclaimMethod_Madvise:
+        return "madvise";
+    }
+    return "unknown";
+}
+
+ReclaimManager::ReclaimManager()
+    : m_generation(0)
+    , m_isMadviseAvailable(true)
+    , m_passes(0)
+    , m_lastFreed(0)
+    , m_totalFreed(0)
+{
+}
+
+ReclaimManager::~ReclaimManager()
+{
+}
+
+void ReclaimManager::initialize(GMainLoop* mainloop)
+{
+}
+
+long long ReclaimManager::reclaim()
+{
+    if (!SettingManager::getInstance().isReclaimEnabled())
+        return 0;
+    // Closing applications is the only way then
+    if (MemoryInfoManager::getInstance().isSwapSaturated())
+        return 0;
+
+    long long now = Time::getSystemTimeInMs();
+    long long interval = SettingManager::getInstance().getReclaimInterval();
+    long long budget = (long long)SettingManager::getInstance().getReclaimBudget() * 1024 * 1024;
+    long long freed = 0;
+    int count = 0;
+
+    // From the lowest priority
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = applications.rbegin(); it != applications.rend() && budget > 0; ++it) {
+        Application& application = **it;
+        if (application.getApplicationStatus() == ApplicationStatus_Foreground || application.isClosing())
+            continue;
+
+        auto record = m_records.find(application.getAppId());
+        if (record != m_records.end() && now - record->second.time < interval)
+            continue;
+
+        enum ReclaimMethod method = getMethod(application);
+        if (method == ReclaimMethod_None)
+            continue;
+
+        // Resident memory is the upper bound of the request
+        long long bytes = (long long)application.getProcessGroup().getPss() * 1024;
+        if (bytes > budget)
+            bytes = budget;
+        if (bytes <= 0)
+            continue;
+        budget -= bytes;
+
+        long long appFreed = 0;
+        if (method == ReclaimMethod_Cgroup)
+            appFreed = reclaimByCgroup(application, bytes);
+        else
+            appFreed = reclaimByMadvise(application, bytes);
+
+        if (record == m_records.end()) {
+            Record newRecord;
+            newRecord.count = 0;
+            newRecord.totalFreed = 0;
+            record = m_records.insert(make_pair(application.getAppId(), newRecord)).first;
+        }
+        record->second.method = method;
+        record->second.time = now;
+        record->second.count++;
+        record->second.lastFreed = appFreed;
+        record->second.totalFreed += appFreed;
+
+        LOG_NORMAL("Reclaimed (" + toString(method) + ") - " + application.getAppId() +
+                   " requested(" + to_string(bytes / 1024) + "KB) freed(" + to_string(appFreed / 1024) + "KB)", LOG_NAME);
+        freed += appFreed;
+        count++;
+    }
+
+    if (count == 0)
+        return 0;
+
+    m_passes++;
+    m_lastFreed = freed;
+    m_totalFreed += freed;
+    m_generation++;
+    return freed;
+}
+
+void ReclaimManager::remove(const string& appId)
+{
+    if (m_records.erase(appId) > 0)
+        m_generation++;
+}
+
+enum ReclaimMethod ReclaimManager::getMethod(Application& application)
+{
+    string method = SettingManager::getInstance().getReclaimMethod();
+    bool isCgroup = application.getCgroup().isReclaimable();
+
+    if (method == "cgroup")
+        return isCgroup ? ReclaimMethod_Cgroup : ReclaimMethod_None;
+    if (method == "madvise")
+        return m_isMadviseAvailable ? ReclaimMethod_Madvise : ReclaimMethod_None;
+
+    if (isCgroup)
+        return ReclaimMethod_Cgroup;
+    return m_isMadviseAvailable ? ReclaimMethod_Madvise : ReclaimMethod_None;
+}
+
+long long ReclaimManager::reclaimByCgroup(Application& application, long long bytes)
+{
+    MemoryCgroup& cgroup = application.getCgroup();
+    cgroup.update();
+    long long before = cgroup.getCurrent();
+
+    // Fails with EAGAIN if less than requested is reclaimed
+    if (!cgroup.reclaim(bytes))
+        LOG_VERBOSE("Partially reclaimed - " + cgroup.getPath(), LOG_NAME);
+
+    application.updateMemory();
+    long long freed = before - cgroup.getCurrent();
+    return freed > 0 ? freed : 0;
+}
+
+long long ReclaimManager::reclaimByMadvise(Application& application, long long bytes)
+{
+    int advice = MADV_PAGEOUT;
+    if (SettingManager::getInstance().getReclaimAdvice() == "cold")
+        advice = MADV_COLD;
+
+    long before = application.getProcessGroup().getPss();
+    long long advised = 0;
+
+    const map<int, Process>& processes = application.getProcessGroup().getProcesses();
+    for (auto it = processes.begin(); it != processes.end() && advised < bytes; ++it) {
+        vector<MemoryRegion> regions;
+        if (!Proc::getAnonymousRegions(it->first, regions) || regions.empty())
+            continue;
+
+        int pidfd = PidFd::open(it->first);
+        if (pidfd < 0)
+            continue;
+
+        vector<struct iovec> iov;
+        for (auto region = regions.begin(); region != regions.end() && advised < bytes; ++region) {
+            long long size = region->end - region->start;
+            if (size > bytes - advised)
+                size = bytes - advised;
+            struct iovec item;
+            item.iov_base = (void*)region->start;
+            item.iov_len = size;
+            iov.push_back(item);
+            advised += size;
+        }
+
+        // A call takes IOV_MAX ranges at most
+        for (size_t i = 0; i < iov.size(); i += IOV_MAX) {
+            size_t count = iov.size() - i;
+            if (count > IOV_MAX)
+                count = IOV_MAX;
+            if (PidFd::madvise(pidfd, &iov[i], count, advice) >= 0)
+                continue;
+
+            if (errno == ENOSYS) {
+                LOG_WARNING("process_madvise is not supported", LOG_NAME);
+                m_isMadviseAvailable = false;
+                close(pidfd);
+                return 0;
+            }
+            LOG_VERBOSE("Failed to advise " + to_string(it->first) + " - " + strerror(errno), LOG_NAME);
+            break;
+        }
+        close(pidfd);
+    }
+
+    application.updateMemory();
+    long long freed = (long long)(before - application.getProcessGroup().getPss()) * 1024;
+    return freed > 0 ? freed : 0;
+}
+
+void ReclaimManager::print()
+{
+    LOG_VERBOSE("PASSES(" + to_string(m_passes) + ") APPS(" + to_string(m_records.size()) + ") " +
+                "LAST(" + to_string(m_lastFreed / 1024) + "KB) TOTAL(" + to_string(m_totalFreed / 1024) + "KB)", LOG_NAME);
+}
+
+void ReclaimManager::print(JValue& json)
+{
+    // MB
+    JValue reclaim = pbnjson::Object();
+    reclaim.put("passes", m_passes);
+    reclaim.put("lastFreed", (int)(m_lastFreed / 1024 / 1024));
+    reclaim.put("totalFreed", (int)(m_totalFreed / 1024 / 1024));
+
+    JValue applications = pbnjson::Array();
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        JValue item = pbnjson::Object();
+        item.put("appId", it->first);
+        item.put("method", toString(it->second.method));
+        item.put("count", it->second.count);
+        item.put("lastFreed", (int)(it->second.lastFreed / 1024 / 1024));
+        item.put("totalFreed", (int)(it->second.totalFreed / 1024 / 1024));
+        applications.append(item);
+    }
+    reclaim.put("applications", applications);
+    json.put("reclaim", reclaim);
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef RECLAIM_RECLAIMMANAGER_H_
+#define RECLAIM_RECLAIMMANAGER_H_
+
+#include <iostream>
+#include <map>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "base/Application.h"
+#include "base/IManager.h"
+#include "base/IPrintable.h"
+
+using namespace std;
+using namespace pbnjson;
+
+enum ReclaimMethod {
+    ReclaimMethod_None,
+    // 'memory.reclaim' of the application cgroup
+    ReclaimMethod_Cgroup,
+    // 'process_madvise' over anonymous mappings of each process
+    ReclaimMethod_Madvise,
+};
+
+class ReclaimManagerListener {
+public:
+    ReclaimManagerListener() {};
+    virtual ~ReclaimManagerListener() {};
+
+};
+
+// Pushes memory of background applications out to swap (zram) so that
+// they can be kept alive instead of being closed. Applications at the
+// tail of the priority order are reclaimed first within a budget per tick.
+class ReclaimManager : public IManager<ReclaimManagerListener>,
+                       public IPrintable {
+public:
+    static string toString(enum ReclaimMethod method);
+
+    static ReclaimManager& getInstance()
+    {
+        static ReclaimManager s_instance;
+        return s_instance;
+    }
+
+    virtual ~ReclaimManager();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    // Returns freed bytes
+    long long reclaim();
+    // The application is terminated
+    void remove(const string& appId);
+
+    // Changed whenever printed values are changed
+    unsigned long getGeneration()
+    {
+        return m_generation;
+    }
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    struct Record {
+        enum ReclaimMethod method;
+        long long time;
+        int count;
+        // bytes
+        long long lastFreed;
+        long long totalFreed;
+    };
+
+    ReclaimManager();
+
+    enum ReclaimMethod getMethod(Application& application);
+    // Returns freed bytes
+    long long reclaimByCgroup(Application& application, long long bytes);
+    long long reclaimByMadvise(Application& application, long long bytes);
+
+    map<string, Record> m_records;
+    unsigned long m_generation;
+    // Cleared if the kernel does not provide 'process_madvise'
+    bool m_isMadviseAvailable;
+
+    int m_passes;
+    long long m_lastFreed;
+    long long m_totalFreed;
+};
+
+#endif /* RECLAIM_RECLAIMMANAGER_H_ */
@@ -16,55 +16,742 @@
 
 #include "SettingManager.h"
 
+#include <errno.h>
+#include <glib-unix.h>
+#include <libgen.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "util/Logger.h"
+
+#define LOG_NAME            "SettingManager"
+
+// Editors write the file several times in a row
+#define RELOAD_DELAY        200
+
+gboolean SettingManager::_onFileChanged(gint fd, GIOCondition condition, gpointer user_data)
+{
+    SettingManager* self = (SettingManager*)user_data;
+    char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+    string path = SETTING_PATH;
+    string name = path.substr(path.find_last_of('/') + 1);
+    bool changed = false;
+
+    ssize_t size;
+    while ((size = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* ptr = buffer; ptr < buffer + size; ) {
+            struct inotify_event* event = (struct inotify_event*)ptr;
+            if (event->len > 0 && name == event->name)
+                changed = true;
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    if (changed && self->m_reloadSrc == 0)
+        self->m_reloadSrc = g_timeout_add(RELOAD_DELAY, _reload, self);
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean SettingManager::_reload(gpointer user_data)
+{
+    SettingManager* self = (SettingManager*)user_data;
+    self->m_reloadSrc = 0;
+
+    if (self->load() && self->m_listener)
+        self->m_listener->onSettingChanged();
+    return G_SOURCE_REMOVE;
+}
+
+void SettingManager::get(JValue json, const string& key, int& value)
+{
+    if (json.isObject() && json.hasKey(key) && json[key].isNumber())
+        json[key].asNumber(value);
+}
+
+void SettingManager::get(JValue json, const string& key, bool& value)
+{
+    if (json.isObject() && json.hasKey(key) && json[key].isBoolean())
+        json[key].asBool(value);
+}
+
+void SettingManager::get(JValue json, const string& key, string& value)
+{
+    if (json.isObject() && json.hasKey(key) && json[key].isString())
+        json[key].asString(value);
+}
+
+void SettingManager::get(JValue json, const string& key, vector<string>& value)
+{
+    if (!json.isObject() || !json.hasKey(key) || !json[key].isArray())
+        return;
+
+    value.clear();
+    for (JValue item : json[key].items()) {
+        if (item.isString())
+            value.push_back(item.asString());
+    }
+}
+
+void SettingManager::get(JValue json, ThresholdProfile& profile)
+{
+    get(json, "watermarkRatio", profile.watermarkRatio);
+    get(json, "criticalRatio", profile.criticalRatio);
+    get(json, "lowRatio", profile.lowRatio);
+    get(json, "criticalHysteresis", profile.criticalHysteresis);
+    get(json, "lowHysteresis", profile.lowHysteresis);
+    get(json, "includeCma", profile.includeCma);
+}
+
 SettingManager::SettingManager()
-    : m_lowEnter(DEFAULT_LOW_ENTER)
-    , m_lowExit(DEFAULT_LOW_EXIT)
-    , m_criticalEnter(DEFAULT_CRITICAL_ENTER)
-    , m_criticalExit(DEFAULT_CRITICAL_EXIT)
+    : m_inotifyFd(-1)
+    , m_inotifySrc(0)
+    , m_reloadSrc(0)
 {
+    m_setting.autoThreshold = false;
+    memset(&m_setting.thresholdInput, 0, sizeof(m_setting.thresholdInput));
+
+    m_setting.lowEnter = DEFAULT_LOW_ENTER;
+    m_setting.lowExit = DEFAULT_LOW_EXIT;
+    m_setting.criticalEnter = DEFAULT_CRITICAL_ENTER;
+    m_setting.criticalExit = DEFAULT_CRITICAL_EXIT;
+
+    m_setting.defaultRequiredMemory = DEFAULT_REQUIRED_MEMORY;
+    m_setting.retryCount = DEFAULT_RETRY_COUNT;
+    m_setting.verbose = DEFAULT_VERBOSE;
+
+    m_setting.requireMemoryInterval = DEFAULT_REQUIRE_INTERVAL;
+    m_setting.killInterval = DEFAULT_KILL_INTERVAL;
+    m_setting.killDeadline = DEFAULT_KILL_DEADLINE;
+    m_setting.killTermTimeout = DEFAULT_KILL_TERM_TIMEOUT;
+    m_setting.statusPostInterval = DEFAULT_STATUS_POST_INTERVAL;
+
+    m_setting.sampleInterval = DEFAULT_SAMPLE_INTERVAL;
+    m_setting.tickInterval = DEFAULT_TICK_INTERVAL;
+    m_setting.psiTickInterval = DEFAULT_PSI_TICK_INTERVAL;
+
+    m_setting.psiEnabled = true;
+    m_setting.psiSomeStall = DEFAULT_PSI_SOME_STALL;
+    m_setting.psiFullStall = DEFAULT_PSI_FULL_STALL;
+    m_setting.psiWindow = DEFAULT_PSI_WINDOW;
+
+    m_setting.swapEnabled = true;
+    m_setting.swapDevice = DEFAULT_SWAP_DEVICE;
+    m_setting.swapRatio = DEFAULT_SWAP_RATIO;
+    m_setting.swapMinRatio = DEFAULT_SWAP_MIN_RATIO;
+    m_setting.swapWeight = DEFAULT_SWAP_WEIGHT;
+    m_setting.swapSaturation = DEFAULT_SWAP_SATURATION;
+
+    // Opt-in. Samples are taken every tick even while NORMAL.
+    m_setting.forecastEnabled = false;
+    m_setting.forecastMethod = DEFAULT_FORECAST_METHOD;
+    m_setting.forecastWindow = DEFAULT_FORECAST_WINDOW;
+    m_setting.forecastHorizon = DEFAULT_FORECAST_HORIZON;
+    m_setting.forecastAlpha = DEFAULT_FORECAST_ALPHA;
+
+    m_setting.profileEnabled = true;
+    m_setting.profilePath = DEFAULT_PROFILE_PATH;
+    m_setting.profileLaunchPeriod = DEFAULT_PROFILE_LAUNCH_PERIOD;
+    m_setting.profileMinLaunches = DEFAULT_PROFILE_MIN_LAUNCHES;
+    m_setting.profileMargin = DEFAULT_PROFILE_MARGIN;
+    m_setting.profileMaxCount = DEFAULT_PROFILE_MAX_COUNT;
+
+    m_setting.trimEnabled = true;
+    m_setting.trimGrace = DEFAULT_TRIM_GRACE;
+
+    // Opt-in. The daemon launches applications through SAM by itself.
+    m_setting.preloadEnabled = false;
+    m_setting.preloadBudget = DEFAULT_PRELOAD_BUDGET;
+    m_setting.preloadMaxCount = DEFAULT_PRELOAD_MAX_COUNT;
+    m_setting.preloadInterval = DEFAULT_PRELOAD_INTERVAL;
+
+    m_setting.freezerEnabled = true;
+    m_setting.freezerIdleTime = DEFAULT_FREEZER_IDLE_TIME;
+    m_setting.freezerOnLow = true;
+
+    m_setting.reclaimEnabled = true;
+    m_setting.reclaimMethod = DEFAULT_RECLAIM_METHOD;
+    m_setting.reclaimAdvice = DEFAULT_RECLAIM_ADVICE;
+    m_setting.reclaimBudget = DEFAULT_RECLAIM_BUDGET;
+    m_setting.reclaimInterval = DEFAULT_RECLAIM_INTERVAL;
+
+    m_setting.cgroupEnabled = true;
+    m_setting.cgroupRoot = DEFAULT_CGROUP_ROOT;
+    m_setting.cgroupParent = DEFAULT_CGROUP_PARENT;
+    m_setting.cgroupLowRatio = DEFAULT_CGROUP_LOW_HIGH;
+    m_setting.cgroupCriticalRatio = DEFAULT_CGROUP_CRIT_HIGH;
 }
 
 SettingManager::~SettingManager()
 {
+    if (m_reloadSrc > 0)
+        g_source_remove(m_reloadSrc);
+    if (m_inotifySrc > 0)
+        g_source_remove(m_inotifySrc);
+    if (m_inotifyFd >= 0)
+        close(m_inotifyFd);
 }
 
 void SettingManager::initialize(GMainLoop* mainloop)
 {
+    load();
+    watch();
+}
+
+bool SettingManager::load(const string& path)
+{
+    if (access(path.c_str(), F_OK) != 0) {
+        LOG_NORMAL("No setting file. Use default values - " + path, LOG_NAME);
+        return false;
+    }
 
+    JValue json = JDomParser::fromFile(path.c_str());
+    if (!json.isObject()) {
+        LOG_WARNING("Invalid setting file - " + path, LOG_NAME);
+        return false;
+    }
+
+    // All values are replaced at once or none of them
+    Setting setting = m_setting;
+    parse(json, setting);
+    if (setting.autoThreshold && !derive(json, setting)) {
+        LOG_WARNING("Failed to derive thresholds. Use fixed values", LOG_NAME);
+        setting.autoThreshold = false;
+    }
+    if (!validate(setting)) {
+        LOG_WARNING("Invalid setting values. Keep previous values - " + path, LOG_NAME);
+        return false;
+    }
+    m_setting = setting;
+    LOG_NORMAL("Setting is loaded - " + path, LOG_NAME);
+    return true;
+}
+
+void SettingManager::parse(JValue& json, Setting& setting)
+{
+    JValue threshold = json["threshold"];
+    get(threshold["low"], "enter", setting.lowEnter);
+    get(threshold["low"], "exit", setting.lowExit);
+    get(threshold["critical"], "enter", setting.criticalEnter);
+    get(threshold["critical"], "exit", setting.criticalExit);
+    setting.autoThreshold = false;
+    get(threshold["auto"], "enable", setting.autoThreshold);
+
+    JValue requireMemory = json["requireMemory"];
+    get(requireMemory, "defaultRequiredMemory", setting.defaultRequiredMemory);
+    get(requireMemory, "retryCount", setting.retryCount);
+    get(requireMemory, "interval", setting.requireMemoryInterval);
+
+    JValue kill = json["kill"];
+    get(kill, "interval", setting.killInterval);
+    get(kill, "deadline", setting.killDeadline);
+    get(kill, "termTimeout", setting.killTermTimeout);
+
+    JValue tick = json["tick"];
+    get(tick, "interval", setting.tickInterval);
+    get(tick, "psiInterval", setting.psiTickInterval);
+    get(tick, "sampleInterval", setting.sampleInterval);
+    get(tick, "statusPostInterval", setting.statusPostInterval);
+
+    JValue psi = json["psi"];
+    get(psi, "enable", setting.psiEnabled);
+    get(psi, "someStall", setting.psiSomeStall);
+    get(psi, "fullStall", setting.psiFullStall);
+    get(psi, "window", setting.psiWindow);
+    get(psi, "cgroups", setting.psiCgroups);
+
+    JValue swap = json["swap"];
+    get(swap, "enable", setting.swapEnabled);
+    get(swap, "device", setting.swapDevice);
+    get(swap, "ratio", setting.swapRatio);
+    get(swap, "minRatio", setting.swapMinRatio);
+    get(swap, "weight", setting.swapWeight);
+    get(swap, "saturation", setting.swapSaturation);
+
+    JValue forecast = json["forecast"];
+    get(forecast, "enable", setting.forecastEnabled);
+    get(forecast, "method", setting.forecastMethod);
+    get(forecast, "window", setting.forecastWindow);
+    get(forecast, "horizon", setting.forecastHorizon);
+    get(forecast, "alpha", setting.forecastAlpha);
+
+    JValue profile = json["profile"];
+    get(profile, "enable", setting.profileEnabled);
+    get(profile, "path", setting.profilePath);
+    get(profile, "launchPeriod", setting.profileLaunchPeriod);
+    get(profile, "minLaunches", setting.profileMinLaunches);
+    get(profile, "margin", setting.profileMargin);
+    get(profile, "maxCount", setting.profileMaxCount);
+
+    JValue trim = json["trim"];
+    get(trim, "enable", setting.trimEnabled);
+    get(trim, "grace", setting.trimGrace);
+
+    JValue preload = json["preload"];
+    get(preload, "enable", setting.preloadEnabled);
+    get(preload, "budget", setting.preloadBudget);
+    get(preload, "maxCount", setting.preloadMaxCount);
+    get(preload, "interval", setting.preloadInterval);
+
+    JValue freezer = json["freezer"];
+    get(freezer, "enable", setting.freezerEnabled);
+    get(freezer, "idleTime", setting.freezerIdleTime);
+    get(freezer, "onLow", setting.freezerOnLow);
+
+    JValue reclaim = json["reclaim"];
+    get(reclaim, "enable", setting.reclaimEnabled);
+    get(reclaim, "method", setting.reclaimMethod);
+    get(reclaim, "advice", setting.reclaimAdvice);
+    get(reclaim, "budget", setting.reclaimBudget);
+    get(reclaim, "interval", setting.reclaimInterval);
+
+    JValue cgroup = json["cgroup"];
+    get(cgroup, "enable", setting.cgroupEnabled);
+    get(cgroup, "root", setting.cgroupRoot);
+    get(cgroup, "parent", setting.cgroupParent);
+    get(cgroup, "lowRatio", setting.cgroupLowRatio);
+    get(cgroup, "criticalRatio", setting.cgroupCriticalRatio);
+
+    get(json["log"], "verbose", setting.verbose);
+}
+
+bool SettingManager::derive(JValue& json, Setting& setting)
+{
+    ThresholdProfile profile;
+    profile.watermarkRatio = DEFAULT_AUTO_WATERMARK_RATIO;
+    profile.criticalRatio = DEFAULT_AUTO_CRITICAL_RATIO;
+    profile.lowRatio = DEFAULT_AUTO_LOW_RATIO;
+    profile.criticalHysteresis = DEFAULT_AUTO_CRITICAL_HYSTERESIS;
+    profile.lowHysteresis = DEFAULT_AUTO_LOW_HYSTERESIS;
+    profile.includeCma = true;
+
+    // 'default' profile is applied first and the selected one overrides it
+    JValue autoThreshold = json["threshold"]["auto"];
+    setting.thresholdProfile = "default";
+    get(autoThreshold, "profile", setting.thresholdProfile);
+    get(autoThreshold["profiles"]["default"], profile);
+    if (setting.thresholdProfile != "default")
+        get(autoThreshold["profiles"][setting.thresholdProfile], profile);
+
+    MemInfoSnapshot memInfo;
+    if (!Proc::getMemoryInfo(memInfo) || memInfo.memTotal <= 0)
+        return false;
+
+    ThresholdInput& input = setting.thresholdInput;
+    input.total = memInfo.memTotal;
+    input.cma = memInfo.cmaTotal > 0 ? memInfo.cmaTotal : 0;
+    if (!Proc::getMinFree(input.minFree))
+        input.minFree = 0;
+    if (!Proc::getZoneInfo(input.zone))
+        memset(&input.zone, 0, sizeof(input.zone));
+
+    // Without zoneinfo, the high watermark is about 125% of min_free_kbytes
+    long high = input.zone.high;
+    if (high <= 0 && input.minFree > 0)
+        high = input.minFree * 5 / 4;
+    if (high <= 0)
+        return false;
+
+    // CMA pages are counted as free but only movable pages can use them
+    input.reserve = high * profile.watermarkRatio / 100;
+    if (profile.includeCma)
+        input.reserve += input.cma;
+
+    setting.criticalEnter = (input.reserve + input.total * profile.criticalRatio / 1000) / 1024;
+    setting.lowEnter = (input.reserve + input.total * profile.lowRatio / 1000) / 1024;
+    setting.criticalExit = setting.criticalEnter * (100 + profile.criticalHysteresis) / 100;
+    setting.lowExit = setting.lowEnter * (100 + profile.lowHysteresis) / 100;
+
+    LOG_NORMAL("Thresholds (" + setting.thresholdProfile + ") - " +
+               "CRITICAL(" + to_string(setting.criticalEnter) + "/" + to_string(setting.criticalExit) + ") " +
+               "LOW(" + to_string(setting.lowEnter) + "/" + to_string(setting.lowExit) + ")", LOG_NAME);
+    return true;
+}
+
+bool SettingManager::validate(const Setting& setting)
+{
+    // Each level needs hysteresis and CRITICAL must be under LOW
+    if (setting.criticalEnter <= 0 ||
+        setting.criticalEnter > setting.criticalExit ||
+        setting.criticalExit > setting.lowEnter ||
+        setting.lowEnter > setting.lowExit)
+        return false;
+
+    if (setting.defaultRequiredMemory <= 0 || setting.retryCount < 0)
+        return false;
+
+    if (setting.requireMemoryInterval <= 0 || setting.killInterval <= 0 ||
+        setting.killDeadline <= 0 || setting.killTermTimeout <= 0 ||
+        setting.statusPostInterval < 0)
+        return false;
+
+    if (setting.sampleInterval <= 0 || setting.tickInterval <= 0 || setting.psiTickInterval <= 0)
+        return false;
+
+    if (setting.psiSomeStall <= 0 || setting.psiFullStall <= 0 ||
+        setting.psiSomeStall > setting.psiWindow || setting.psiFullStall > setting.psiWindow)
+        return false;
+
+    if (setting.swapRatio <= 100 || setting.swapMinRatio < 100 ||
+        setting.swapWeight < 0 || setting.swapWeight > 100 ||
+        setting.swapSaturation <= 0 || setting.swapSaturation > 100)
+        return false;
+
+    if ((setting.forecastMethod != "regression" && setting.forecastMethod != "ewma") ||
+        setting.forecastWindow <= 0 || setting.forecastHorizon < 0 ||
+        setting.forecastAlpha <= 0 || setting.forecastAlpha > 100)
+        return false;
+
+    if (setting.profilePath.empty() || setting.profileLaunchPeriod < 0 ||
+        setting.profileMinLaunches < 1 || setting.profileMargin < 0 || setting.profileMaxCount <= 0)
+        return false;
+
+    if (setting.trimGrace < 0)
+        return false;
+
+    if (setting.preloadBudget < 0 || setting.preloadBudget > 100 ||
+        setting.preloadMaxCount < 0 || setting.preloadInterval < 0)
+        return false;
+
+    if (setting.freezerIdleTime < 0)
+        return false;
+
+    if ((setting.reclaimMethod != "auto" && setting.reclaimMethod != "cgroup" &&
+         setting.reclaimMethod != "madvise") ||
+        (setting.reclaimAdvice != "pageout" && setting.reclaimAdvice != "cold") ||
+        setting.reclaimBudget <= 0 || setting.reclaimInterval < 0)
+        return false;
+
+    if (setting.cgroupLowRatio <= 0 || setting.cgroupLowRatio > 100 ||
+        setting.cgroupCriticalRatio <= 0 || setting.cgroupCriticalRatio > 100)
+        return false;
+    return true;
+}
+
+void SettingManager::watch()
+{
+    // The directory is watched because the file can be replaced by rename
+    char path[] = SETTING_PATH;
+    string dir = dirname(path);
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        LOG_WARNING("Failed to init inotify - " + string(strerror(errno)), LOG_NAME);
+        return;
+    }
+    if (inotify_add_watch(m_inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        LOG_WARNING("Failed to watch " + dir + " - " + string(strerror(errno)), LOG_NAME);
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return;
+    }
+    m_inotifySrc = g_unix_fd_add(m_inotifyFd, G_IO_IN, _onFileChanged, this);
 }
 
 int SettingManager::getLowEnter()
 {
-    return m_lowEnter;
+    return m_setting.lowEnter;
 }
 
 int SettingManager::getLowExit()
 {
-    return m_lowExit;
+    return m_setting.lowExit;
 }
 
 int SettingManager::getCriticalEnter()
 {
-    return m_criticalEnter;
+    return m_setting.criticalEnter;
 }
 
 int SettingManager::getCriticalExit()
 {
-    return m_criticalExit;
+    return m_setting.criticalExit;
+}
+
+bool SettingManager::isAutoThreshold()
+{
+    return m_setting.autoThreshold;
+}
+
+void SettingManager::printThreshold(JValue& json)
+{
+    json.put("mode", m_setting.autoThreshold ? "auto" : "fixed");
+    if (!m_setting.autoThreshold)
+        return;
+
+    const ThresholdInput& input = m_setting.thresholdInput;
+    JValue watermark = pbnjson::Object();
+    watermark.put("min", (int)(input.zone.min / 1024));
+    watermark.put("low", (int)(input.zone.low / 1024));
+    watermark.put("high", (int)(input.zone.high / 1024));
+
+    JValue autoThreshold = pbnjson::Object();
+    autoThreshold.put("profile", m_setting.thresholdProfile);
+    autoThreshold.put("total", (int)(input.total / 1024));
+    autoThreshold.put("minFree", (int)(input.minFree / 1024));
+    autoThreshold.put("cma", (int)(input.cma / 1024));
+    autoThreshold.put("reserve", (int)(input.reserve / 1024));
+    autoThreshold.put("watermark", watermark);
+    json.put("auto", autoThreshold);
 }
 
 int SettingManager::getDefaultRequiredMemory()
 {
-    return 120;
+    return m_setting.defaultRequiredMemory;
 }
 
 int SettingManager::getRetryCount()
 {
-    return 5;
+    return m_setting.retryCount;
 }
 
 bool SettingManager::isVerbose()
 {
-    return true;
+    return m_setting.verbose;
+}
+
+int SettingManager::getRequireMemoryInterval()
+{
+    return m_setting.requireMemoryInterval;
+}
+
+int SettingManager::getKillInterval()
+{
+    return m_setting.killInterval;
+}
+
+int SettingManager::getKillDeadline()
+{
+    return m_setting.killDeadline;
+}
+
+int SettingManager::getKillTermTimeout()
+{
+    return m_setting.killTermTimeout;
+}
+
+int SettingManager::getStatusPostInterval()
+{
+    return m_setting.statusPostInterval;
+}
+
+int SettingManager::getSampleInterval()
+{
+    return m_setting.sampleInterval;
+}
+
+int SettingManager::getTickInterval()
+{
+    return m_setting.tickInterval;
 }
 
+int SettingManager::getPsiTickInterval()
+{
+    return m_setting.psiTickInterval;
+}
+
+bool SettingManager::isPsiEnabled()
+{
+    return m_setting.psiEnabled;
+}
+
+int SettingManager::getPsiSomeStall()
+{
+    return m_setting.psiSomeStall;
+}
+
+int SettingManager::getPsiFullStall()
+{
+    return m_setting.psiFullStall;
+}
+
+int SettingManager::getPsiWindow()
+{
+    return m_setting.psiWindow;
+}
+
+vector<string> SettingManager::getPsiCgroups()
+{
+    return m_setting.psiCgroups;
+}
+
+bool SettingManager::isForecastEnabled()
+{
+    return m_setting.forecastEnabled;
+}
+
+string SettingManager::getForecastMethod()
+{
+    return m_setting.forecastMethod;
+}
+
+int SettingManager::getForecastWindow()
+{
+    return m_setting.forecastWindow;
+}
+
+int SettingManager::getForecastHorizon()
+{
+    return m_setting.forecastHorizon;
+}
+
+int SettingManager::getForecastAlpha()
+{
+    return m_setting.forecastAlpha;
+}
+
+bool SettingManager::isSwapEnabled()
+{
+    return m_setting.swapEnabled;
+}
+
+string SettingManager::getSwapDevice()
+{
+    return m_setting.swapDevice;
+}
+
+int SettingManager::getSwapRatio()
+{
+    return m_setting.swapRatio;
+}
+
+int SettingManager::getSwapMinRatio()
+{
+    return m_setting.swapMinRatio;
+}
+
+int SettingManager::getSwapWeight()
+{
+    return m_setting.swapWeight;
+}
+
+int SettingManager::getSwapSaturation()
+{
+    return m_setting.swapSaturation;
+}
+
+bool SettingManager::isProfileEnabled()
+{
+    return m_setting.profileEnabled;
+}
+
+string SettingManager::getProfilePath()
+{
+    return m_setting.profilePath;
+}
+
+int SettingManager::getProfileLaunchPeriod()
+{
+    return m_setting.profileLaunchPeriod;
+}
+
+int SettingManager::getProfileMinLaunches()
+{
+    return m_setting.profileMinLaunches;
+}
+
+int SettingManager::getProfileMargin()
+{
+    return m_setting.profileMargin;
+}
+
+int SettingManager::getProfileMaxCount()
+{
+    return m_setting.profileMaxCount;
+}
+
+bool SettingManager::isTrimEnabled()
+{
+    return m_setting.trimEnabled;
+}
+
+int SettingManager::getTrimGrace()
+{
+    return m_setting.trimGrace;
+}
+
+bool SettingManager::isPreloadEnabled()
+{
+    return m_setting.preloadEnabled;
+}
+
+int SettingManager::getPreloadBudget()
+{
+    return m_setting.preloadBudget;
+}
+
+int SettingManager::getPreloadMaxCount()
+{
+    return m_setting.preloadMaxCount;
+}
+
+int SettingManager::getPreloadInterval()
+{
+    return m_setting.preloadInterval;
+}
+
+bool SettingManager::isFreezerEnabled()
+{
+    return m_setting.freezerEnabled;
+}
+
+int SettingManager::getFreezerIdleTime()
+{
+    return m_setting.freezerIdleTime;
+}
+
+bool SettingManager::isFreezerOnLow()
+{
+    return m_setting.freezerOnLow;
+}
+
+bool SettingManager::isReclaimEnabled()
+{
+    return m_setting.reclaimEnabled;
+}
+
+string SettingManager::getReclaimMethod()
+{
+    return m_setting.reclaimMethod;
+}
+
+string SettingManager::getReclaimAdvice()
+{
+    return m_setting.reclaimAdvice;
+}
+
+int SettingManager::getReclaimBudget()
+{
+    return m_setting.reclaimBudget;
+}
+
+int SettingManager::getReclaimInterval()
+{
+    return m_setting.reclaimInterval;
+}
+
+bool SettingManager::isCgroupEnabled()
+{
+    return m_setting.cgroupEnabled;
+}
+
+string SettingManager::getCgroupRoot()
+{
+    return m_setting.cgroupRoot;
+}
+
+string SettingManager::getCgroupParent()
+{
+    return m_setting.cgroupParent;
+}
+
+int SettingManager::getCgroupLowRatio()
+{
+    return m_setting.cgroupLowRatio;
+}
+
+int SettingManager::getCgroupCriticalRatio()
+{
+    return m_setting.cgroupCriticalRatio;
+}
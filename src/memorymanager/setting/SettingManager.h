@@ -18,21 +18,113 @@
 #define SETTING_SETTINGMANAGER_H_
 
 #include <iostream>
+#include <vector>
+#include <glib.h>
+#include <pbnjson.hpp>
 
 #include "base/IManager.h"
+#include "util/Proc.h"
+
+// Installed from 'files/conf/memorymanager.json.in'
+#ifndef SETTING_PATH
+#define SETTING_PATH              "/etc/palm/memorymanager.json"
+#endif
+
+#define DEFAULT_REQUIRED_MEMORY   120
+#define DEFAULT_RETRY_COUNT       5
+#define DEFAULT_VERBOSE           true
 
 #define DEFAULT_LOW_EXIT          280
 #define DEFAULT_LOW_ENTER         250
 #define DEFAULT_CRITICAL_EXIT     130
 #define DEFAULT_CRITICAL_ENTER    100
 
+// Automatic thresholds ('threshold.auto')
+// reserve = high watermark * WATERMARK% + CMA
+// enter   = reserve + MemTotal * RATIO/1000
+// exit    = enter * (100 + HYSTERESIS)%
+#define DEFAULT_AUTO_WATERMARK_RATIO      200
+#define DEFAULT_AUTO_CRITICAL_RATIO       35
+#define DEFAULT_AUTO_LOW_RATIO            70
+#define DEFAULT_AUTO_CRITICAL_HYSTERESIS  30
+#define DEFAULT_AUTO_LOW_HYSTERESIS       12
+
+// Swap (zram) which can still be used is added to the available memory
+// gain = min(SwapFree, anon) * (1 - 1/ratio) * WEIGHT%
+#define DEFAULT_SWAP_DEVICE       "zram0"
+// Compression ratio in % until enough data is stored in zram
+#define DEFAULT_SWAP_RATIO        300
+// zram is saturated below this compression ratio (%)
+#define DEFAULT_SWAP_MIN_RATIO    150
+#define DEFAULT_SWAP_WEIGHT       50
+// zram is saturated if this % of swap or its memory limit is used
+#define DEFAULT_SWAP_SATURATION   90
+
+#define DEFAULT_FORECAST_METHOD   "regression"
+#define DEFAULT_FORECAST_WINDOW   10000
+#define DEFAULT_FORECAST_HORIZON  5000
+#define DEFAULT_FORECAST_ALPHA    30
+
+#define DEFAULT_PROFILE_PATH          "/var/lib/memorymanager/footprint.db"
+#define DEFAULT_PROFILE_LAUNCH_PERIOD 10
+#define DEFAULT_PROFILE_MIN_LAUNCHES  1
+#define DEFAULT_PROFILE_MARGIN        10
+#define DEFAULT_PROFILE_MAX_COUNT     256
+
+// Applications are closed if pressure remains after the grace period
+// of the last trim notification (milliseconds)
+#define DEFAULT_TRIM_GRACE        2000
+
+// Memory for preloaded applications in % of MemTotal
+#define DEFAULT_PRELOAD_BUDGET    10
+#define DEFAULT_PRELOAD_MAX_COUNT 2
+// At most one application is preloaded in this (milliseconds)
+#define DEFAULT_PRELOAD_INTERVAL  30000
+
+// Background applications are frozen after they are idle for this
+// (milliseconds) or when the level reaches LOW
+#define DEFAULT_FREEZER_IDLE_TIME 60000
+
+// Proactive reclaim of background applications in LOW
+// 'auto' uses 'memory.reclaim' of the application cgroup if available
+// and 'process_madvise' otherwise
+#define DEFAULT_RECLAIM_METHOD    "auto"
+#define DEFAULT_RECLAIM_ADVICE    "pageout"
+// MB per tick
+#define DEFAULT_RECLAIM_BUDGET    64
+// An application is reclaimed again after this (milliseconds)
+#define DEFAULT_RECLAIM_INTERVAL  10000
+
+#define DEFAULT_REQUIRE_INTERVAL  100
+#define DEFAULT_KILL_INTERVAL     1000
+#define DEFAULT_KILL_DEADLINE     3000
+#define DEFAULT_KILL_TERM_TIMEOUT 1000
+
+#define DEFAULT_SAMPLE_INTERVAL   5
+
+#define DEFAULT_STATUS_POST_INTERVAL 500
+
+#define DEFAULT_CGROUP_ROOT       "/sys/fs/cgroup"
+#define DEFAULT_CGROUP_PARENT     "memorymanager"
+#define DEFAULT_CGROUP_LOW_HIGH   90
+#define DEFAULT_CGROUP_CRIT_HIGH  75
+
+#define DEFAULT_TICK_INTERVAL     1
+#define DEFAULT_PSI_TICK_INTERVAL 10
+#define DEFAULT_PSI_SOME_STALL    150
+#define DEFAULT_PSI_FULL_STALL    50
+#define DEFAULT_PSI_WINDOW        1000
+
 using namespace std;
+using namespace pbnjson;
 
 class SettingManagerListener {
 public:
     SettingManagerListener() {};
     virtual ~SettingManagerListener() {};
 
+    // The setting file is reloaded. All getters return new values.
+    virtual void onSettingChanged() = 0;
 };
 
 class SettingManager : public IManager<SettingManagerListener> {
@@ -49,22 +141,220 @@ public:
     // IManager
     void initialize(GMainLoop* mainloop);
 
+    // Returns false if the file is invalid. The previous values are kept then.
+    bool load(const string& path = SETTING_PATH);
+
     int getLowEnter();
     int getLowExit();
     int getCriticalEnter();
     int getCriticalExit();
 
+    // Thresholds are derived from watermarks and MemTotal
+    bool isAutoThreshold();
+    void printThreshold(JValue& json);
+
     int getDefaultRequiredMemory();
     int getRetryCount();
     bool isVerbose();
 
+    // requireMemory (milliseconds)
+    int getRequireMemoryInterval();
+    int getKillInterval();
+
+    // Kill escalation (milliseconds)
+    int getKillDeadline();
+    int getKillTermTimeout();
+
+    // Coalescing interval of memory status posts (milliseconds)
+    int getStatusPostInterval();
+
+    // Tick (seconds)
+    int getSampleInterval();
+    int getTickInterval();
+    int getPsiTickInterval();
+
+    // PSI (milliseconds)
+    bool isPsiEnabled();
+    int getPsiSomeStall();
+    int getPsiFullStall();
+    int getPsiWindow();
+    vector<string> getPsiCgroups();
+
+    // Forecast of available memory
+    bool isForecastEnabled();
+    string getForecastMethod();
+    // Samples in the window are used (milliseconds)
+    int getForecastWindow();
+    // LOW reclaim starts if CRITICAL is expected within the horizon (milliseconds)
+    int getForecastHorizon();
+    // Weight of the latest slope in EWMA (%)
+    int getForecastAlpha();
+
+    // Swap aware available memory
+    bool isSwapEnabled();
+    string getSwapDevice();
+    int getSwapRatio();
+    int getSwapMinRatio();
+    int getSwapWeight();
+    int getSwapSaturation();
+
+    // Learned footprint of applications
+    bool isProfileEnabled();
+    string getProfilePath();
+    // Usage within the period after the launch is not the steady state (seconds)
+    int getProfileLaunchPeriod();
+    // Profiles are used after this number of launches
+    int getProfileMinLaunches();
+    // Added to the learned peak (%)
+    int getProfileMargin();
+    int getProfileMaxCount();
+
+    // Trim notifications to background applications
+    bool isTrimEnabled();
+    int getTrimGrace();
+
+    // Preloading of likely launched applications
+    bool isPreloadEnabled();
+    int getPreloadBudget();
+    int getPreloadMaxCount();
+    int getPreloadInterval();
+
+    // Freezer of background applications
+    bool isFreezerEnabled();
+    int getFreezerIdleTime();
+    bool isFreezerOnLow();
+
+    // Proactive reclaim
+    bool isReclaimEnabled();
+    string getReclaimMethod();
+    string getReclaimAdvice();
+    int getReclaimBudget();
+    int getReclaimInterval();
+
+    // cgroup v2
+    bool isCgroupEnabled();
+    string getCgroupRoot();
+    string getCgroupParent();
+    // 'memory.high' of background applications in % of their current usage
+    int getCgroupLowRatio();
+    int getCgroupCriticalRatio();
+
 private:
+    struct ThresholdProfile {
+        int watermarkRatio;
+        int criticalRatio;
+        int lowRatio;
+        int criticalHysteresis;
+        int lowHysteresis;
+        bool includeCma;
+    };
+
+    // Inputs of the automatic thresholds (KB)
+    struct ThresholdInput {
+        long total;
+        long minFree;
+        long cma;
+        long reserve;
+        ZoneInfoSnapshot zone;
+    };
+
+    struct Setting {
+        bool autoThreshold;
+        string thresholdProfile;
+        ThresholdInput thresholdInput;
+
+        int lowEnter;
+        int lowExit;
+        int criticalEnter;
+        int criticalExit;
+
+        int defaultRequiredMemory;
+        int retryCount;
+        bool verbose;
+
+        int requireMemoryInterval;
+        int killInterval;
+        int killDeadline;
+        int killTermTimeout;
+        int statusPostInterval;
+
+        int sampleInterval;
+        int tickInterval;
+        int psiTickInterval;
+
+        bool psiEnabled;
+        int psiSomeStall;
+        int psiFullStall;
+        int psiWindow;
+        // 'memory.pressure' files of cgroups to be monitored in addition to the system
+        vector<string> psiCgroups;
+
+        bool swapEnabled;
+        string swapDevice;
+        int swapRatio;
+        int swapMinRatio;
+        int swapWeight;
+        int swapSaturation;
+
+        bool forecastEnabled;
+        string forecastMethod;
+        int forecastWindow;
+        int forecastHorizon;
+        int forecastAlpha;
+
+        bool profileEnabled;
+        string profilePath;
+        int profileLaunchPeriod;
+        int profileMinLaunches;
+        int profileMargin;
+        int profileMaxCount;
+
+        bool trimEnabled;
+        int trimGrace;
+
+        bool preloadEnabled;
+        int preloadBudget;
+        int preloadMaxCount;
+        int preloadInterval;
+
+        bool freezerEnabled;
+        int freezerIdleTime;
+        bool freezerOnLow;
+
+        bool reclaimEnabled;
+        string reclaimMethod;
+        string reclaimAdvice;
+        int reclaimBudget;
+        int reclaimInterval;
+
+        bool cgroupEnabled;
+        string cgroupRoot;
+        string cgroupParent;
+        int cgroupLowRatio;
+        int cgroupCriticalRatio;
+    };
+
+    static gboolean _onFileChanged(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean _reload(gpointer user_data);
+
+    static void get(JValue json, const string& key, int& value);
+    static void get(JValue json, const string& key, bool& value);
+    static void get(JValue json, const string& key, string& value);
+    static void get(JValue json, const string& key, vector<string>& value);
+    static void get(JValue json, ThresholdProfile& profile);
+
     SettingManager();
 
-    int m_lowEnter;
-    int m_lowExit;
-    int m_criticalEnter;
-    int m_criticalExit;
+    void parse(JValue& json, Setting& setting);
+    bool derive(JValue& json, Setting& setting);
+    bool validate(const Setting& setting);
+    void watch();
+
+    Setting m_setting;
+
+    int m_inotifyFd;
+    guint m_inotifySrc;
+    guint m_reloadSrc;
 };
 
 #endif /* SETTING_SETTINGMANAGER_H_ */
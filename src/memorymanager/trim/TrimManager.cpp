@@ -0,0 +1,249 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TrimManager.h"
+
+#include <vector>
+
+#include "freezer/FreezeManager.h"
+#include "luna/LunaManager.h"
+#include "luna/client/ApplicationManager.h"
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/Time.h"
+
+#define LOG_NAME            "TrimManager"
+
+// Levels are sent again if the pressure lasts longer than this (ms).
+// Applications grow again after they are trimmed.
+#define TRIM_EXPIRE         60000
+
+string TrimManager::toString(enum TrimLevel level)
+{
+    switch (level) {
+    case TrimLevel_None:
+        return "none";
+
+    case TrimLevel_Moderate:
+        return "moderate";
+
+    case TrimLevel_Background:
+        return "background";
+
+    case TrimLevel_Complete:
+        return "complete";
+    }
+    return "unknown";
+}
+
+gboolean TrimManager::_measure(gpointer user_data)
+{
+    TrimManager* self = (TrimManager*)user_data;
+    self->m_measureSrc = 0;
+    self->measure();
+    return G_SOURCE_REMOVE;
+}
+
+TrimManager::TrimManager()
+    : m_generation(0)
+    , m_measureSrc(0)
+{
+}
+
+TrimManager::~TrimManager()
+{
+    if (m_measureSrc > 0)
+        g_source_remove(m_measureSrc);
+}
+
+void TrimManager::initialize(GMainLoop* mainloop)
+{
+}
+
+bool TrimManager::trim(enum MemoryLevel level)
+{
+    if (!SettingManager::getInstance().isTrimEnabled())
+        return false;
+
+    long long now = Time::getSystemTimeInMs();
+    long long grace = SettingManager::getInstance().getTrimGrace();
+
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        if (it->second.level != TrimLevel_None && now - it->second.time >= TRIM_EXPIRE)
+            it->second.level = TrimLevel_None;
+    }
+
+    // From the lowest priority
+    vector<pair<Application*, enum TrimLevel>> targets;
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = applications.rbegin(); it != applications.rend(); ++it) {
+        Application& application = **it;
+        if (application.getApplicationStatus() == ApplicationStatus_Foreground || application.isClosing())
+            continue;
+        if (!LunaManager::getInstace().hasTrimSubscriber(application.getAppId()))
+            continue;
+
+        auto record = m_records.find(application.getAppId());
+        enum TrimLevel cur = TrimLevel_None;
+        if (record != m_records.end())
+            cur = record->second.level;
+
+        enum TrimLevel next = TrimLevel_Complete;
+        if (level != MemoryLevel_CRITICAL) {
+            next = (cur < TrimLevel_Moderate) ? TrimLevel_Moderate : TrimLevel_Background;
+            // A level is escalated after the grace period of the previous one
+            if (cur != TrimLevel_None && now - record->second.time < grace)
+                continue;
+        }
+        if (cur >= next)
+            continue;
+        targets.push_back(make_pair(&application, next));
+    }
+
+    // Applications which were notified recently are given time to release
+    // memory. In CRITICAL, the kernel may already be in direct reclaim, so
+    // closing applications is never delayed.
+    bool isWaiting = false;
+    for (auto it = m_records.begin(); it != m_records.end() && level != MemoryLevel_CRITICAL; ++it) {
+        if (it->second.level != TrimLevel_None && now - it->second.time < grace)
+            isWaiting = true;
+    }
+    if (targets.empty())
+        return isWaiting;
+
+    // The shortage to the exit threshold is shared by notified applications
+    int exit = (level == MemoryLevel_CRITICAL) ?
+        SettingManager::getInstance().getCriticalExit() :
+        SettingManager::getInstance().getLowExit();
+    long shortage = exit - MemoryInfoManager::getInstance().getFree();
+    int target = (int)(shortage / (long)targets.size());
+    if (target <= 0)
+        target = 1;
+
+    bool isNotified = false;
+    for (auto it = targets.begin(); it != targets.end(); ++it) {
+        isNotified |= notify(*it->first, it->second, target);
+    }
+    if (isNotified && m_measureSrc == 0)
+        m_measureSrc = g_timeout_add(grace, _measure, this);
+    if (level == MemoryLevel_CRITICAL)
+        return false;
+    return isNotified || isWaiting;
+}
+
+void TrimManager::reset()
+{
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        it->second.level = TrimLevel_None;
+    }
+}
+
+void TrimManager::remove(const string& appId)
+{
+    LunaManager::getInstace().removeTrimEvent(appId);
+    if (m_records.erase(appId) > 0)
+        m_generation++;
+}
+
+bool TrimManager::notify(Application& application, enum TrimLevel level, int target)
+{
+    const string& appId = application.getAppId();
+    // The application needs to run to release memory
+    FreezeManager::getInstance().thaw(application);
+    if (!LunaManager::getInstace().postTrimEvent(appId, toString(level), target))
+        return false;
+
+    auto it = m_records.find(appId);
+    if (it == m_records.end()) {
+        Record record;
+        record.level = TrimLevel_None;
+        record.time = 0;
+        record.target = 0;
+        record.before = 0;
+        record.isMeasuring = false;
+        record.count = 0;
+        record.lastReleased = 0;
+        record.totalReleased = 0;
+        it = m_records.insert(make_pair(appId, record)).first;
+    }
+
+    Record& record = it->second;
+    record.level = level;
+    record.time = Time::getSystemTimeInMs();
+    record.target = target;
+    record.before = application.getProcessGroup().getPss();
+    record.isMeasuring = true;
+    record.count++;
+    m_generation++;
+
+    LOG_NORMAL("Trim (" + toString(level) + ") - " + appId + " target(" + to_string(target) + "MB)", LOG_NAME);
+    return true;
+}
+
+void TrimManager::measure()
+{
+    ApplicationRegistry& applications = ApplicationManager::getInstance().getApplications();
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        Record& record = it->second;
+        if (!record.isMeasuring)
+            continue;
+        record.isMeasuring = false;
+
+        Application* application = applications.find(it->first);
+        if (application == nullptr)
+            continue;
+
+        application->updateMemory();
+        long released = (record.before - application->getProcessGroup().getPss()) / 1024;
+        if (released < 0)
+            released = 0;
+        record.lastReleased = released;
+        record.totalReleased += released;
+
+        LOG_NORMAL("Trimmed (" + toString(record.level) + ") - " + it->first +
+                   " released(" + to_string(released) + "MB) target(" + to_string(record.target) + "MB)", LOG_NAME);
+    }
+    m_generation++;
+}
+
+void TrimManager::print()
+{
+    int notified = 0;
+    long released = 0;
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        if (it->second.level != TrimLevel_None)
+            notified++;
+        released += it->second.totalReleased;
+    }
+    LOG_VERBOSE("APPS(" + to_string(m_records.size()) + ") NOTIFIED(" + to_string(notified) + ") " +
+                "RELEASED(" + to_string(released) + "MB)", LOG_NAME);
+}
+
+void TrimManager::print(JValue& json)
+{
+    JValue trim = pbnjson::Array();
+    for (auto it = m_records.begin(); it != m_records.end(); ++it) {
+        JValue item = pbnjson::Object();
+        item.put("appId", it->first);
+        item.put("level", toString(it->second.level));
+        item.put("count", it->second.count);
+        item.put("target", it->second.target);
+        item.put("released", (int)it->second.lastReleased);
+        item.put("totalReleased", (int)it->second.totalReleased);
+        trim.append(item);
+    }
+    json.put("trim", trim);
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TRIM_TRIMMANAGER_H_
+#define TRIM_TRIMMANAGER_H_
+
+#include <iostream>
+#include <map>
+#include <glib.h>
+#include <pbnjson.hpp>
+
+#include "base/Application.h"
+#include "base/IManager.h"
+#include "base/IPrintable.h"
+#include "memoryinfo/MemoryInfoManager.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Grades of trim notifications. Later ones ask for more memory.
+enum TrimLevel {
+    TrimLevel_None,
+    TrimLevel_Moderate,
+    TrimLevel_Background,
+    TrimLevel_Complete,
+};
+
+class TrimManagerListener {
+public:
+    TrimManagerListener() {};
+    virtual ~TrimManagerListener() {};
+
+};
+
+// Asks background applications to release memory before they are closed.
+// Each application receives each level once while the pressure lasts and
+// the memory it actually released is recorded.
+class TrimManager : public IManager<TrimManagerListener>,
+                    public IPrintable {
+public:
+    static string toString(enum TrimLevel level);
+
+    static TrimManager& getInstance()
+    {
+        static TrimManager s_instance;
+        return s_instance;
+    }
+
+    virtual ~TrimManager();
+
+    // IManager
+    void initialize(GMainLoop* mainloop);
+
+    // Notifies the next level to subscribed background applications.
+    // Returns true if closing applications should wait for them (never in CRITICAL).
+    bool trim(enum MemoryLevel level);
+    // The pressure is resolved. All levels can be sent again.
+    void reset();
+    // The application is terminated
+    void remove(const string& appId);
+
+    // Changed whenever printed values are changed
+    unsigned long getGeneration()
+    {
+        return m_generation;
+    }
+
+    // IPrintable
+    virtual void print();
+    virtual void print(JValue& json);
+
+private:
+    struct Record {
+        enum TrimLevel level;
+        long long time;
+        // MB
+        int target;
+        // PSS when notified (KB)
+        long before;
+        bool isMeasuring;
+        int count;
+        // MB
+        long lastReleased;
+        long totalReleased;
+    };
+
+    static gboolean _measure(gpointer user_data);
+
+    TrimManager();
+
+    bool notify(Application& application, enum TrimLevel level, int target);
+    void measure();
+
+    map<string, Record> m_records;
+    unsigned long m_generation;
+
+    guint m_measureSrc;
+};
+
+#endif /* TRIM_TRIMMANAGER_H_ */
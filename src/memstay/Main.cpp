@@ -28,16 +28,22 @@ int main(int argc, char** argv)
     int interval = 1;
     int unit = 1;
     bool free = false;
+    enum MemoryType type = MemoryType_Anon;
+    int threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int compressible = 50;
 
     if (argc == 1) {
         long total, available;
         Proc::getMemoryInfo(total, available);
-        cerr << "[memstay] Three parameters are needed (optional)" << endl;
+        cerr << "[memstay] Parameters are optional" << endl;
         cerr << "[memstay] #1 : Allocation Target (mb) - Default 200mb"  << endl;
         cerr << "[memstay] #2 : Allocation Interval (ms) - Default 1ms"  << endl;
         cerr << "[memstay] #3 : Allocation Unit (mb) - Default 1mb" << endl;
         cerr << "[memstay] #4 : Enable free operation - Default 'false'" << endl;
-        cerr << "[memstay] #5 : Total(" << total << ") Free(" << available << ")" << endl;
+        cerr << "[memstay] #5 : Memory type (anon, file, shmem, mlock, compress, thp) - Default 'anon'" << endl;
+        cerr << "[memstay] #6 : Threads touching pages - Default " << threads << endl;
+        cerr << "[memstay] #7 : Compressible ratio (%) of 'compress' - Default 50" << endl;
+        cerr << "[memstay] Total(" << total << ") Free(" << available << ")" << endl;
         return 0;
     }
     if (argc >= 2) {
@@ -52,16 +58,35 @@ int main(int argc, char** argv)
     if (argc >= 5 && strcmp(argv[4], "free") == 0) {
         free = true;
     }
+    if (argc >= 6 && !MemStay::toEnum(argv[5], type)) {
+        cerr << "[memstay] Unknown memory type - " << argv[5] << endl;
+        return 1;
+    }
+    if (argc >= 7) {
+        threads = atoi(argv[6]);
+    }
+    if (argc >= 8) {
+        compressible = atoi(argv[7]);
+        if (compressible < 0 || compressible > 100) {
+            cerr << "[memstay] Compressible ratio must be 0 - 100" << endl;
+            return 1;
+        }
+    }
 
-    cout << "[memstay] Allocation : target(" << argv[1] << "MB) / "
-         << "interval(" << argv[2] << "ms) / "
-         << "unit(" << argv[3] << "MB) / "
-         << (free ? "free(enabled)" : "free(disabled)") << endl;
+    cout << "[memstay] Allocation : target(" << target << "MB) / "
+         << "interval(" << interval << "ms) / "
+         << "unit(" << unit << "MB) / "
+         << (free ? "free(enabled)" : "free(disabled)") << " / "
+         << "type(" << MemStay::toString(type) << ") / "
+         << "threads(" << threads << ")" << endl;
 
     MemStay::getInstance().setTarget(target);
     MemStay::getInstance().setInterval(interval);
     MemStay::getInstance().setUnit(unit);
     MemStay::getInstance().setFree(free);
+    MemStay::getInstance().setType(type);
+    MemStay::getInstance().setThreads(threads);
+    MemStay::getInstance().setCompressible(compressible);
     MemStay::getInstance().configure();
 
     GMainLoop* mainLoop = g_main_loop_new(NULL, FALSE);
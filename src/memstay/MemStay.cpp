@@ -15,13 +15,73 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "MemStay.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
 #include "util/Proc.h"
 
+// Not defined by old headers
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE   14
+#endif
+
+// Temporary files are created on a disk, not on tmpfs
+#define FILE_TEMPLATE   "/var/tmp/memstay.XXXXXX"
+
+string MemStay::toString(enum MemoryType type)
+{
+    switch (type) {
+    case MemoryType_Anon:
+        return "anon";
+
+    case MemoryType_File:
+        return "file";
+
+    case MemoryType_Shmem:
+        return "shmem";
+
+    case MemoryType_Mlock:
+        return "mlock";
+
+    case MemoryType_Compress:
+        return "compress";
+
+    case MemoryType_Thp:
+        return "thp";
+    }
+    return "unknown";
+}
+
+bool MemStay::toEnum(const string& str, enum MemoryType& type)
+{
+    if (str == "anon")
+        type = MemoryType_Anon;
+    else if (str == "file")
+        type = MemoryType_File;
+    else if (str == "shmem")
+        type = MemoryType_Shmem;
+    else if (str == "mlock")
+        type = MemoryType_Mlock;
+    else if (str == "compress")
+        type = MemoryType_Compress;
+    else if (str == "thp")
+        type = MemoryType_Thp;
+    else
+        return false;
+    return true;
+}
+
 MemStay::MemStay()
     : m_target(0)
     , m_interval(0)
     , m_unit(0)
     , m_free(false)
+    , m_type(MemoryType_Anon)
+    , m_threads(1)
+    , m_compressible(50)
     , m_allocationSize(0)
 {
 }
@@ -50,51 +110,152 @@ void MemStay::setFree(bool free)
     m_free = free;
 }
 
+void MemStay::setType(enum MemoryType type)
+{
+    m_type = type;
+}
+
+void MemStay::setThreads(int threads)
+{
+    m_threads = threads;
+}
+
+void MemStay::setCompressible(int compressible)
+{
+    m_compressible = compressible;
+}
+
 void MemStay::configure()
 {
+    m_toucher.start(m_threads);
     g_timeout_add(m_interval, _tick, NULL);
 }
 
 gboolean MemStay::_tick(gpointer data)
 {
-    long totalMemory;
-    long freeMemory;
+    MemInfoSnapshot snapshot;
 
-    if (!Proc::getMemoryInfo(totalMemory, freeMemory))
+    if (!Proc::getMemoryInfo(snapshot))
         return G_SOURCE_CONTINUE;
 
-    int size = MemStay::getInstance().m_unit * 1024 * 1024;
-    void* buffer = NULL;
+    MemStay& memStay = MemStay::getInstance();
+    // Page cache is counted in MemAvailable
+    long freeMemory = (memStay.m_type == MemoryType_File ? snapshot.memFree : snapshot.memAvailable) / 1024;
+    Allocation allocation;
 
-    if (freeMemory > MemStay::getInstance().m_target && freeMemory - MemStay::getInstance().m_unit > 0) {
-        buffer = malloc(size);
-        if (buffer == NULL) {
+    if (freeMemory > memStay.m_target && freeMemory - memStay.m_unit > 0) {
+        if (!memStay.allocate((size_t)memStay.m_unit * 1024 * 1024, allocation)) {
             cerr << "[memstay] Allocation Fails" << endl;
             return TRUE;
         }
-        memset(buffer, 1, size);
-
-        MemStay::getInstance().m_allocationSize += MemStay::getInstance().m_unit;
-        MemStay::getInstance().m_allocations.push_back(buffer);
-        MemStay::getInstance().print('+', freeMemory);
-    } else if (MemStay::getInstance().m_free && (freeMemory + MemStay::getInstance().m_unit) < MemStay::getInstance().m_target) {
-        void* freeBuffer = MemStay::getInstance().m_allocations.back();
-        free(freeBuffer);
-
-        MemStay::getInstance().m_allocationSize -= MemStay::getInstance().m_unit;
-        MemStay::getInstance().m_allocations.pop_back();
-        MemStay::getInstance().print('-', freeMemory);
+
+        memStay.m_allocationSize += memStay.m_unit;
+        memStay.m_allocations.push_back(allocation);
+        memStay.print('+', freeMemory);
+    } else if (memStay.m_free && !memStay.m_allocations.empty() && (freeMemory + memStay.m_unit) < memStay.m_target) {
+        memStay.release(memStay.m_allocations.back());
+
+        memStay.m_allocationSize -= memStay.m_unit;
+        memStay.m_allocations.pop_back();
+        memStay.print('-', freeMemory);
     } else {
-        MemStay::getInstance().print('=', freeMemory);
+        memStay.print('=', freeMemory);
     }
     return G_SOURCE_CONTINUE;
 }
 
+bool MemStay::allocate(size_t size, Allocation& allocation)
+{
+    int fd = -1;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    switch (m_type) {
+    case MemoryType_File:
+        fd = openFile();
+        // Blocks are reserved, so that a full disk does not raise SIGBUS
+        if (fd < 0 || posix_fallocate(fd, 0, size) != 0) {
+            cerr << "[memstay] Failed to create the file - " << FILE_TEMPLATE << endl;
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        flags = MAP_SHARED;
+        break;
+
+    case MemoryType_Shmem:
+#ifdef __NR_memfd_create
+        fd = syscall(__NR_memfd_create, "memstay", 0);
+#endif
+        if (fd < 0 || ftruncate(fd, size) != 0) {
+            cerr << "[memstay] Failed to create memfd - " << strerror(errno) << endl;
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        flags = MAP_SHARED;
+        break;
+
+    default:
+        break;
+    }
+
+    // Huge pages need an aligned range
+    size_t length = (m_type == MemoryType_Thp) ? size + HUGE_PAGE_SIZE : size;
+    void* address = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (address == MAP_FAILED) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    char* buffer = (char*)address;
+
+    if (m_type == MemoryType_Thp) {
+        char* aligned = (char*)(((uintptr_t)buffer + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1));
+        if (aligned > buffer)
+            munmap(buffer, aligned - buffer);
+        if (buffer + length > aligned + size)
+            munmap(aligned + size, buffer + length - (aligned + size));
+        buffer = aligned;
+
+        if (madvise(buffer, size, MADV_HUGEPAGE) != 0)
+            cerr << "[memstay] THP is not available - " << strerror(errno) << endl;
+    }
+
+    m_toucher.touch(buffer, size, m_type == MemoryType_Compress ? m_compressible : PageToucher::SAME_FILLED);
+
+    if (m_type == MemoryType_Mlock && mlock(buffer, size) != 0) {
+        cerr << "[memstay] Failed to lock - " << strerror(errno) << endl;
+        munmap(buffer, size);
+        return false;
+    }
+
+    allocation.buffer = buffer;
+    allocation.size = size;
+    allocation.fd = fd;
+    return true;
+}
+
+void MemStay::release(Allocation& allocation)
+{
+    // Page cache of the unlinked file is dropped with the last reference
+    munmap(allocation.buffer, allocation.size);
+    if (allocation.fd >= 0)
+        close(allocation.fd);
+}
+
+int MemStay::openFile()
+{
+    char path[] = FILE_TEMPLATE;
+    int fd = mkstemp(path);
+    if (fd < 0)
+        return -1;
+
+    unlink(path);
+    return fd;
+}
+
 void MemStay::print(char type, long available)
 {
     cout << "[memstay] " << type << " : "
          << "Target(" << m_target << "MB) "
          << "Free("  << available << "MB) "
-         << "Hold("  << m_allocationSize << "MB)"
+         << "Hold("  << m_allocationSize << "MB " << toString(m_type) << ")"
          << endl;
 }
@@ -28,8 +28,25 @@
 #include <unistd.h>
 #include <malloc.h>
 
+#include "PageToucher.h"
+
 using namespace std;
 
+enum MemoryType {
+    // Anonymous pages filled with a single byte
+    MemoryType_Anon = 0,
+    // Page cache of a temporary file. Reclaimable, so MemFree is the target.
+    MemoryType_File,
+    // memfd (tmpfs) pages. Only swap can reclaim them.
+    MemoryType_Shmem,
+    // Unevictable anonymous pages
+    MemoryType_Mlock,
+    // Anonymous pages which compress by the given ratio (zram)
+    MemoryType_Compress,
+    // Anonymous transparent huge pages
+    MemoryType_Thp,
+};
+
 class MemStay {
 public:
     static MemStay& getInstance()
@@ -40,28 +57,51 @@ public:
 
     static int getFreeMemory();
 
+    static string toString(enum MemoryType type);
+    static bool toEnum(const string& str, enum MemoryType& type);
+
     virtual ~MemStay();
 
     void setTarget(int target);
     void setInterval(int interval);
     void setUnit(int unit);
     void setFree(bool free);
+    void setType(enum MemoryType type);
+    void setThreads(int threads);
+    void setCompressible(int compressible);
 
     void configure();
 
 private:
+    struct Allocation {
+        char* buffer;
+        size_t size;
+        // -1 for anonymous memory
+        int fd;
+    };
+
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
     static gboolean _tick(gpointer data);
 
     MemStay();
 
+    bool allocate(size_t size, Allocation& allocation);
+    void release(Allocation& allocation);
+    int openFile();
+
     void print(char type, long available);
 
     int m_target;
     guint32 m_interval;
     int m_unit;
     bool m_free;
+    enum MemoryType m_type;
+    int m_threads;
+    int m_compressible;
 
-    vector<void*> m_allocations;
+    PageToucher m_toucher;
+    vector<Allocation> m_allocations;
     long m_allocationSize;
 };
 
@@ -0,0 +1,148 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "PageToucher.h"
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+PageToucher::PageToucher()
+    : m_pageSize(sysconf(_SC_PAGESIZE))
+    , m_generation(0)
+    , m_running(0)
+    , m_isStopped(false)
+    , m_buffer(nullptr)
+    , m_size(0)
+    , m_compressible(SAME_FILLED)
+{
+}
+
+PageToucher::~PageToucher()
+{
+    stop();
+}
+
+void PageToucher::start(int threads)
+{
+    if (threads < 1)
+        threads = 1;
+
+    m_isStopped = false;
+    for (int i = 0; i < threads; ++i) {
+        m_workers.push_back(thread(&PageToucher::run, this, i));
+    }
+}
+
+void PageToucher::stop()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_isStopped = true;
+    }
+    m_start.notify_all();
+
+    for (auto it = m_workers.begin(); it != m_workers.end(); ++it) {
+        it->join();
+    }
+    m_workers.clear();
+}
+
+void PageToucher::touch(char* buffer, size_t size, int compressible)
+{
+    if (m_workers.empty()) {
+        uint32_t seed = 1;
+        for (size_t offset = 0; offset < size; offset += m_pageSize) {
+            fill(buffer + offset, min(m_pageSize, size - offset), compressible, seed);
+        }
+        return;
+    }
+
+    unique_lock<mutex> lock(m_mutex);
+    m_buffer = buffer;
+    m_size = size;
+    m_compressible = compressible;
+    m_running = m_workers.size();
+    m_generation++;
+    m_start.notify_all();
+
+    while (m_running > 0) {
+        m_done.wait(lock);
+    }
+}
+
+void PageToucher::run(int index)
+{
+    unsigned long generation = 0;
+    // Different contents in each worker
+    uint32_t seed = index + 1;
+
+    while (true) {
+        char* buffer;
+        size_t size;
+        int compressible;
+        int workers;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            while (!m_isStopped && m_generation == generation) {
+                m_start.wait(lock);
+            }
+            if (m_isStopped)
+                return;
+            generation = m_generation;
+            buffer = m_buffer;
+            size = m_size;
+            compressible = m_compressible;
+            workers = m_workers.size();
+        }
+
+        size_t pages = (size + m_pageSize - 1) / m_pageSize;
+        size_t first = pages * index / workers;
+        size_t last = pages * (index + 1) / workers;
+        for (size_t page = first; page < last; ++page) {
+            size_t offset = page * m_pageSize;
+            fill(buffer + offset, min(m_pageSize, size - offset), compressible, seed);
+        }
+
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (--m_running == 0)
+                m_done.notify_one();
+        }
+    }
+}
+
+void PageToucher::fill(char* page, size_t size, int compressible, uint32_t& seed)
+{
+    if (compressible == SAME_FILLED) {
+        memset(page, 1, size);
+        return;
+    }
+
+    // Zeros compress away. The rest is random (xorshift) and does not compress.
+    size_t zeros = (size * compressible / 100) & ~(sizeof(uint32_t) - 1);
+    memset(page, 0, zeros);
+
+    uint32_t* word = (uint32_t*)(page + zeros);
+    uint32_t* end = (uint32_t*)(page + (size & ~(sizeof(uint32_t) - 1)));
+    for (; word < end; ++word) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        *word = seed;
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PAGETOUCHER_H_
+#define PAGETOUCHER_H_
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+using namespace std;
+
+// Writes every page of a buffer with a pool of worker threads.
+// Each worker takes a contiguous range, so page faults run in parallel.
+class PageToucher {
+public:
+    // Pages are filled with a single byte, which zram stores without compression
+    static const int SAME_FILLED = -1;
+
+    PageToucher();
+    virtual ~PageToucher();
+
+    void start(int threads);
+    void stop();
+
+    // Returns when all pages are written. 'compressible' is the ratio (%) of
+    // each page that compresses away, or SAME_FILLED.
+    void touch(char* buffer, size_t size, int compressible);
+
+private:
+    static void fill(char* page, size_t size, int compressible, uint32_t& seed);
+
+    void run(int index);
+
+    size_t m_pageSize;
+
+    vector<thread> m_workers;
+    mutex m_mutex;
+    condition_variable m_start;
+    condition_variable m_done;
+    // Incremented for each request. Workers wait until it changes.
+    unsigned long m_generation;
+    int m_running;
+    bool m_isStopped;
+
+    char* m_buffer;
+    size_t m_size;
+    int m_compressible;
+};
+
+#endif /* PAGETOUCHER_H_ */
@@ -0,0 +1,52 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <iostream>
+#include <pbnjson.hpp>
+
+#include "Simulator.h"
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+
+using namespace std;
+using namespace pbnjson;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        cerr << "[sim] #1 : Trace (JSON lines)" << endl;
+        cerr << "[sim] #2 : Setting file - Default values if not given" << endl;
+        return 1;
+    }
+    Logger::getInstance().setLevel(LogLevel_ERROR);
+
+    // The clock and the memory of the trace are used from here
+    Simulator simulator;
+    if (!simulator.load(argv[1])) {
+        cerr << "[sim] No events in " << argv[1] << endl;
+        return 1;
+    }
+    if (argc > 2 && !SettingManager::getInstance().load(argv[2])) {
+        cerr << "[sim] Failed to load " << argv[2] << endl;
+        return 1;
+    }
+    simulator.run();
+
+    JValue report = pbnjson::Object();
+    simulator.print(report);
+    cout << report.stringify("    ") << endl;
+    return 0;
+}
@@ -0,0 +1,455 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+#include "policy/KillPlanner.h"
+#include "setting/SettingManager.h"
+#include "util/Logger.h"
+#include "util/Proc.h"
+
+#define LOG_NAME    "Simulator"
+
+Simulator::Simulator()
+    : m_seq(0)
+    , m_pending(0)
+    , m_released(0)
+    , m_nextRequestId(0)
+    , m_isReclaimScheduled(false)
+    , m_startTime(-1)
+    , m_levelSince(0)
+    , m_level(MemoryLevel_NORMAL)
+    , m_kills(pbnjson::Array())
+    , m_relaunches(0)
+    , m_requireMemory(pbnjson::Array())
+{
+    memset(&m_trace, -1, sizeof(m_trace));
+    memset(&m_memInfo, -1, sizeof(m_memInfo));
+    memset(m_levelTime, 0, sizeof(m_levelTime));
+
+    Time::setClock(&m_clock);
+    Proc::setMemoryInfoSource(&m_memInfo);
+}
+
+Simulator::~Simulator()
+{
+    Proc::setMemoryInfoSource(nullptr);
+    Time::setClock(nullptr);
+}
+
+bool Simulator::load(const string& path)
+{
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace - " + path, LOG_NAME);
+        return false;
+    }
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        JValue payload = JDomParser::fromString(line);
+        if (!payload.isObject() || !payload["time"].isNumber() || !payload["type"].isString()) {
+            LOG_WARNING("Invalid trace event. Skip line " + to_string(lineNumber), LOG_NAME);
+            continue;
+        }
+        long long time = payload["time"].asNumber<int64_t>();
+        if (m_startTime < 0 || time < m_startTime)
+            m_startTime = time;
+
+        // Settings can be derived from the memory of the trace
+        if (m_trace.memTotal < 0 && payload["type"].asString() == "meminfo")
+            handleMemInfo(payload);
+
+        schedule(time, EventType_Trace, payload);
+        m_pending++;
+    }
+    return (m_pending > 0);
+}
+
+void Simulator::run()
+{
+    if (m_pending == 0)
+        return;
+
+    MemoryInfoManager::getInstance().setListener(this);
+    MemoryInfoManager::getInstance().initialize(nullptr);
+    m_policy.setListener(this);
+    MemoryInfoManager::getInstance().update();
+
+    // PSI triggers are not replayed. Levels are evaluated on ticks and kills.
+    m_clock.advance(m_startTime);
+    m_levelSince = m_startTime;
+    schedule(m_startTime, EventType_Tick);
+
+    while (!m_events.empty()) {
+        Event event = m_events.top();
+        m_events.pop();
+        m_clock.advance(event.time);
+
+        switch (event.type) {
+        case EventType_Trace:
+            m_pending--;
+            handleTrace(event.payload);
+            break;
+
+        case EventType_Tick:
+            MemoryInfoManager::getInstance().update(false);
+            if (m_pending > 0 || m_policy.hasRequests())
+                schedule(event.time + SettingManager::getInstance().getTickInterval() * 1000LL, EventType_Tick);
+            break;
+
+        case EventType_Killed:
+            handleKilled(event.payload.asString());
+            break;
+
+        case EventType_Reclaim:
+            m_isReclaimScheduled = false;
+            m_policy.reclaim();
+            scheduleReclaim();
+            break;
+        }
+    }
+
+    m_levelTime[m_level] += m_clock.now() - m_levelSince;
+    m_levelSince = m_clock.now();
+    m_policy.setListener(nullptr);
+    MemoryInfoManager::getInstance().setListener(nullptr);
+}
+
+void Simulator::print(JValue& json)
+{
+    JValue levels = pbnjson::Object();
+    levels.put("normal", (int64_t)m_levelTime[MemoryLevel_NORMAL]);
+    levels.put("low", (int64_t)m_levelTime[MemoryLevel_LOW]);
+    levels.put("critical", (int64_t)m_levelTime[MemoryLevel_CRITICAL]);
+
+    int failed = 0;
+    long long totalLatency = 0;
+    long long maxLatency = 0;
+    for (JValue item : m_requireMemory.items()) {
+        long long latency = item["latency"].asNumber<int64_t>();
+        if (!item["returnValue"].asBool())
+            failed++;
+        totalLatency += latency;
+        if (latency > maxLatency)
+            maxLatency = latency;
+    }
+    int count = m_requireMemory.arraySize();
+
+    JValue requireMemory = pbnjson::Object();
+    requireMemory.put("count", count);
+    requireMemory.put("failed", failed);
+    requireMemory.put("averageLatency", (int64_t)(count > 0 ? totalLatency / count : 0));
+    requireMemory.put("maxLatency", (int64_t)maxLatency);
+    requireMemory.put("requests", m_requireMemory);
+
+    json.put("duration", (int64_t)(m_startTime < 0 ? 0 : m_clock.now() - m_startTime));
+    json.put("levels", levels);
+    json.put("killCount", (int)m_kills.arraySize());
+    json.put("kills", m_kills);
+    json.put("relaunches", m_relaunches);
+    json.put("requireMemory", requireMemory);
+}
+
+void Simulator::onEnter(enum MemoryLevel prev, enum MemoryLevel cur)
+{
+    long long now = m_clock.now();
+    m_levelTime[m_level] += now - m_levelSince;
+    m_levelSince = now;
+    m_level = cur;
+    LOG_DEBUG("MemoryLevel - " + MemoryInfoManager::toString(cur), LOG_NAME);
+}
+
+void Simulator::onLow()
+{
+    m_policy.onLow();
+}
+
+void Simulator::onCritical()
+{
+    m_policy.onCritical();
+}
+
+bool Simulator::onEvictPreloads()
+{
+    if (!SettingManager::getInstance().isPreloadEnabled())
+        return false;
+
+    bool evicted = false;
+    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
+        Application& application = **it;
+        if (application.getApplicationStatus() != ApplicationStatus_Preload || application.isClosing())
+            continue;
+        close(application, "preload");
+        evicted = true;
+    }
+    return evicted;
+}
+
+bool Simulator::onReclaimSwap()
+{
+    // The trace has no swap usage per application
+    return false;
+}
+
+bool Simulator::onTrim(enum MemoryLevel level)
+{
+    // Applications do not respond to trim events in the trace
+    return false;
+}
+
+bool Simulator::onCloseApp(bool includeForeground, int requiredMemory)
+{
+    return closeApp(includeForeground, requiredMemory);
+}
+
+void Simulator::onUpdateMemory()
+{
+    // The recorded memory is what the daemon would sample
+    for (auto it = m_applications.begin(); it != m_applications.end(); ++it) {
+        Application& application = **it;
+        application.setMemory(m_simApplications[application.getAppId()].memory * 1024L);
+    }
+}
+
+int Simulator::getRunningAppCount()
+{
+    return m_applications.size();
+}
+
+void Simulator::onRequireMemoryProgress(unsigned long id, int requiredMemory, int reclaimed)
+{
+}
+
+void Simulator::onRequireMemoryReply(unsigned long id, bool returnValue, const string& errorText, int reclaimed)
+{
+    auto it = m_requests.find(id);
+    if (it == m_requests.end())
+        return;
+
+    JValue item = pbnjson::Object();
+    item.put("time", (int64_t)it->second.time);
+    item.put("requiredMemory", it->second.requiredMemory);
+    item.put("returnValue", returnValue);
+    if (!returnValue)
+        item.put("errorText", errorText);
+    item.put("reclaimed", reclaimed);
+    item.put("latency", (int64_t)(m_clock.now() - it->second.time));
+    m_requireMemory.append(item);
+    m_requests.erase(it);
+}
+
+void Simulator::schedule(long long time, enum EventType type, JValue payload)
+{
+    Event event;
+    event.time = time;
+    event.seq = m_seq++;
+    event.type = type;
+    event.payload = payload;
+    m_events.push(event);
+}
+
+void Simulator::handleTrace(JValue& payload)
+{
+    string type = payload["type"].asString();
+    if (type == "meminfo")
+        handleMemInfo(payload);
+    else if (type == "life")
+        handleLife(payload);
+    else if (type == "memory")
+        handleMemory(payload);
+    else if (type == "require")
+        handleRequire(payload);
+    else
+        LOG_WARNING("Unknown trace event - " + type, LOG_NAME);
+}
+
+void Simulator::handleMemInfo(JValue& payload)
+{
+    // Formatted as the kernel does, so that the daemon parser is used as is
+    string buffer;
+    for (auto kv : payload.children()) {
+        string key = kv.first.asString();
+        if (key == "time" || key == "type" || !kv.second.isNumber())
+            continue;
+        buffer += key + ": " + to_string((long long)kv.second.asNumber<int64_t>()) + " kB\n";
+    }
+
+    MemInfoSnapshot snapshot;
+    if (!MemInfoReader::parse(buffer.c_str(), buffer.size(), snapshot)) {
+        LOG_WARNING("MemTotal is missing in meminfo event", LOG_NAME);
+        return;
+    }
+    m_trace = snapshot;
+    updateMemInfo();
+}
+
+void Simulator::handleLife(JValue& payload)
+{
+    string appId = payload.hasKey("appId") ? payload["appId"].asString() : payload["id"].asString();
+    string event = payload["event"].asString();
+    if (appId.empty())
+        return;
+
+    SimApplication& simApplication = m_simApplications[appId];
+    if (payload["memory"].isNumber())
+        simApplication.memory = payload["memory"].asNumber<int>();
+
+    if (event == "close" || event == "stop") {
+        // The recorded memory does not include the application anymore.
+        // An application still in the registry was not released yet.
+        if (simApplication.isKilled && !m_applications.isExist(appId))
+            m_released = max(m_released - simApplication.memory * 1024L, 0L);
+        m_applications.remove(appId);
+        m_simApplications.erase(appId);
+        updateMemInfo();
+        return;
+    }
+
+    Application application;
+    application.fromJson(payload);
+    if (simApplication.isKilled) {
+        // Events of a killed application are not replayed until it is launched again
+        if (application.getApplicationStatus() != ApplicationStatus_Foreground &&
+            application.getApplicationStatus() != ApplicationStatus_Preload)
+            return;
+        m_relaunches++;
+        if (m_applications.isExist(appId))
+            m_applications.remove(appId);
+        else
+            m_released = max(m_released - simApplication.memory * 1024L, 0L);
+        simApplication.isKilled = false;
+        updateMemInfo();
+        LOG_DEBUG("Relaunched - " + appId, LOG_NAME);
+    }
+
+    bool isNew = !m_applications.isExist(appId);
+    bool isForeground = (application.getApplicationStatus() == ApplicationStatus_Foreground);
+    m_applications.update(application, !isNew && isForeground);
+}
+
+void Simulator::handleMemory(JValue& payload)
+{
+    string appId = payload["appId"].asString();
+    auto it = m_simApplications.find(appId);
+    if (it == m_simApplications.end() || !payload["memory"].isNumber())
+        return;
+    it->second.memory = payload["memory"].asNumber<int>();
+}
+
+void Simulator::handleRequire(JValue& payload)
+{
+    unsigned long id = m_nextRequestId++;
+    RequireMemoryRequest& request = m_requests[id];
+    request.time = m_clock.now();
+    request.requiredMemory = payload["requiredMemory"].asNumber<int>();
+
+    m_policy.requireMemory(id, request.requiredMemory);
+    scheduleReclaim();
+}
+
+void Simulator::handleKilled(const string& appId)
+{
+    auto it = m_simApplications.find(appId);
+    if (it == m_simApplications.end() || !it->second.isKilled)
+        return;
+
+    m_released += it->second.memory * 1024L;
+    m_applications.remove(appId);
+    updateMemInfo();
+
+    // Memory is released now. Do not wait for the next tick
+    if (m_policy.hasRequests()) {
+        m_policy.reclaim();
+        scheduleReclaim();
+    } else {
+        MemoryInfoManager::getInstance().update(false);
+    }
+}
+
+void Simulator::updateMemInfo()
+{
+    m_memInfo = m_trace;
+    if (m_memInfo.memTotal < 0 || m_released <= 0)
+        return;
+
+    m_memInfo.memAvailable += m_released;
+    if (m_memInfo.memAvailable > m_memInfo.memTotal)
+        m_memInfo.memAvailable = m_memInfo.memTotal;
+    if (m_memInfo.memFree >= 0)
+        m_memInfo.memFree = min(m_memInfo.memFree + m_released, m_memInfo.memTotal);
+}
+
+void Simulator::scheduleReclaim()
+{
+    if (!m_policy.hasRequests() || m_isReclaimScheduled)
+        return;
+    schedule(m_clock.now() + SettingManager::getInstance().getRequireMemoryInterval(), EventType_Reclaim);
+    m_isReclaimScheduled = true;
+}
+
+bool Simulator::closeApp(bool includeForeground, int requiredMemory)
+{
+    if (m_applications.empty())
+        return false;
+
+    if (requiredMemory > 0) {
+        KillPlan plan;
+        if (!KillPlanner::plan(m_applications, requiredMemory, includeForeground, plan))
+            return false;
+        for (auto victim = plan.victims.begin(); victim != plan.victims.end(); ++victim) {
+            Application* application = m_applications.find(*victim);
+            if (application != nullptr && !application->isClosing())
+                close(*application, "requireMemory");
+        }
+        return true;
+    }
+
+    Application& application = m_applications.back();
+    if (!includeForeground && application.getApplicationStatus() == ApplicationStatus_Foreground)
+        return false;
+    if (application.isClosing())
+        return true;
+
+    close(application, MemoryInfoManager::toString(m_level));
+    return true;
+}
+
+void Simulator::close(Application& application, const string& reason)
+{
+    string appId = application.getAppId();
+    application.closing();
+    m_simApplications[appId].isKilled = true;
+
+    JValue item = pbnjson::Object();
+    item.put("time", (int64_t)m_clock.now());
+    item.put("appId", appId);
+    item.put("reason", reason);
+    item.put("memory", m_simApplications[appId].memory);
+    m_kills.append(item);
+    LOG_DEBUG("Close " + appId + " - " + reason, LOG_NAME);
+
+    schedule(m_clock.now() + KILL_LATENCY, EventType_Killed, JValue(appId));
+}
@@ -0,0 +1,161 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include <iostream>
+#include <map>
+#include <queue>
+#include <vector>
+#include <pbnjson.hpp>
+
+#include "VirtualClock.h"
+#include "base/ApplicationRegistry.h"
+#include "memoryinfo/MemoryInfoManager.h"
+#include "policy/MemoryPolicy.h"
+#include "util/MemInfo.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Replays a recorded trace against the memory level machine and the
+// MemoryPolicy of memorymanager with a virtual clock. Nothing is read from
+// the host: zram and zone watermarks are not simulated, so thresholds are
+// derived from MemTotal only.
+//
+// A trace has one JSON object per line. 'time' is milliseconds from the start.
+// {"time":0,"type":"meminfo","MemTotal":1024000,"MemAvailable":400000,...}
+//     Fields of '/proc/meminfo' (KB). Missing fields are missing in the kernel too.
+// {"time":10,"type":"life","appId":"com.app","event":"launch","appType":"web","memory":120}
+//     Application life events of SAM. 'close' and 'stop' remove the application.
+//     'memory' (MB) is planned by the KillPlanner and released when the
+//     simulator kills the application. Preloaded applications are evicted
+//     if preload is enabled. Swap and trim responses are not simulated.
+// {"time":20,"type":"memory","appId":"com.app","memory":150}
+// {"time":30,"type":"require","requiredMemory":200}
+class Simulator : public MemoryInfoManagerListener,
+                  public MemoryPolicyListener {
+public:
+    Simulator();
+    virtual ~Simulator();
+
+    bool load(const string& path);
+    void run();
+
+    void print(JValue& json);
+
+    // MemoryInfoManagerListener
+    virtual void onEnter(enum MemoryLevel prev, enum MemoryLevel cur);
+    virtual void onLow();
+    virtual void onCritical();
+
+    // MemoryPolicyListener
+    virtual bool onEvictPreloads();
+    virtual bool onReclaimSwap();
+    virtual bool onTrim(enum MemoryLevel level);
+    virtual bool onCloseApp(bool includeForeground, int requiredMemory);
+    virtual void onUpdateMemory();
+    virtual int getRunningAppCount();
+    virtual void onRequireMemoryProgress(unsigned long id, int requiredMemory, int reclaimed);
+    virtual void onRequireMemoryReply(unsigned long id, bool returnValue, const string& errorText, int reclaimed);
+
+private:
+    enum EventType {
+        EventType_Trace,
+        EventType_Tick,
+        EventType_Killed,
+        EventType_Reclaim,
+    };
+
+    struct Event {
+        long long time;
+        // Events at the same time are handled in the scheduled order
+        unsigned long seq;
+        enum EventType type;
+        JValue payload;
+    };
+
+    struct EventOrder {
+        bool operator()(const Event& a, const Event& b) const
+        {
+            if (a.time != b.time)
+                return a.time > b.time;
+            return a.seq > b.seq;
+        }
+    };
+
+    struct SimApplication {
+        // MB
+        int memory;
+        bool isKilled;
+    };
+
+    struct RequireMemoryRequest {
+        long long time;
+        int requiredMemory;
+    };
+
+    // Milliseconds between a close request and the release of the memory
+    static const long long KILL_LATENCY = 500;
+
+    void schedule(long long time, enum EventType type, JValue payload = JValue());
+
+    void handleTrace(JValue& payload);
+    void handleMemInfo(JValue& payload);
+    void handleLife(JValue& payload);
+    void handleMemory(JValue& payload);
+    void handleRequire(JValue& payload);
+    void handleKilled(const string& appId);
+
+    void updateMemInfo();
+    void scheduleReclaim();
+
+    // Mirrors ApplicationManager
+    bool closeApp(bool includeForeground, int requiredMemory = 0);
+    void close(Application& application, const string& reason);
+
+    VirtualClock m_clock;
+    priority_queue<Event, vector<Event>, EventOrder> m_events;
+    unsigned long m_seq;
+    // Trace events which are not handled yet
+    int m_pending;
+
+    // Recorded one and the one with simulated kills applied
+    MemInfoSnapshot m_trace;
+    MemInfoSnapshot m_memInfo;
+    // KB released by simulated kills
+    long m_released;
+
+    ApplicationRegistry m_applications;
+    map<string, SimApplication> m_simApplications;
+
+    MemoryPolicy m_policy;
+    map<unsigned long, RequireMemoryRequest> m_requests;
+    unsigned long m_nextRequestId;
+    bool m_isReclaimScheduled;
+
+    // Report
+    long long m_startTime;
+    long long m_levelTime[3];
+    long long m_levelSince;
+    enum MemoryLevel m_level;
+    JValue m_kills;
+    int m_relaunches;
+    JValue m_requireMemory;
+};
+
+#endif /* SIMULATOR_H_ */
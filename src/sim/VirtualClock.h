@@ -0,0 +1,44 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef VIRTUALCLOCK_H_
+#define VIRTUALCLOCK_H_
+
+#include "util/Time.h"
+
+// Time of the trace. It only moves forward when the simulator advances it.
+class VirtualClock : public Clock {
+public:
+    VirtualClock() : m_now(0) {}
+    virtual ~VirtualClock() {}
+
+    void advance(long long time)
+    {
+        if (time > m_now)
+            m_now = time;
+    }
+
+    // Clock
+    virtual long long now()
+    {
+        return m_now;
+    }
+
+private:
+    long long m_now;
+};
+
+#endif /* VIRTUALCLOCK_H_ */
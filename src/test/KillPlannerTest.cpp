@@ -0,0 +1,188 @@
+// Copyright (c) 2018 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <pbnjson.hpp>
+
+#include "base/Application.h"
+#include "base/ApplicationRegistry.h"
+#include "policy/KillPlanner.h"
+#include "util/Logger.h"
+
+using namespace std;
+using namespace pbnjson;
+
+// Reclaimable memory of each application (MB)
+#define APP_MEMORY  10
+
+static int s_failures = 0;
+
+static void expect(bool condition, const string& name, const string& msg)
+{
+    if (condition)
+        return;
+    cerr << "[test] " << name << " : " << msg << endl;
+    s_failures++;
+}
+
+// The first one is foreground and the others are background
+static void populate(ApplicationRegistry& registry, int apps)
+{
+    for (int i = 0; i < apps; ++i) {
+        JValue json = pbnjson::Object();
+        json.put("id", "com.test.app" + to_string(i));
+        json.put("appType", "native");
+        json.put("event", i == 0 ? "foreground" : "background");
+
+        Application application;
+        application.fromJson(json);
+        registry.update(application, true).setMemory(APP_MEMORY * 1024L);
+    }
+}
+
+// The lowest priority applications cover the required memory
+static void testLowestFirst(int apps)
+{
+    string name = "lowestFirst(" + to_string(apps) + ")";
+    ApplicationRegistry registry;
+    populate(registry, apps);
+
+    KillPlan plan;
+    bool result = KillPlanner::plan(registry, APP_MEMORY * 2 + 1, false, plan);
+    expect(result && plan.isSatisfied, name, "not satisfied");
+    expect(plan.victims.size() == 3, name, "victims(" + to_string(plan.victims.size()) + ")");
+
+    // Victims are not ordered
+    auto it = registry.rbegin();
+    for (int i = 0; i < 3 && it != registry.rend(); ++i, ++it) {
+        string appId = (*it)->getAppId();
+        expect(find(plan.victims.begin(), plan.victims.end(), appId) != plan.victims.end(), name, "missing victim " + appId);
+    }
+}
+
+// All applications are needed
+static void testAll(int apps)
+{
+    string name = "all(" + to_string(apps) + ")";
+    ApplicationRegistry registry;
+    populate(registry, apps);
+
+    KillPlan plan;
+    bool result = KillPlanner::plan(registry, APP_MEMORY * apps, true, plan);
+    expect(result && plan.isSatisfied, name, "not satisfied");
+    expect((int)plan.victims.size() == apps, name, "victims(" + to_string(plan.victims.size()) + ")");
+    expect(plan.reclaimable == APP_MEMORY * apps, name, "reclaimable(" + to_string(plan.reclaimable) + ")");
+}
+
+// Exactly the lower half is chosen. Costs of this many candidates exceed 32 bits.
+static void testLowerHalf(int apps)
+{
+    string name = "lowerHalf(" + to_string(apps) + ")";
+    ApplicationRegistry registry;
+    populate(registry, apps);
+
+    KillPlan plan;
+    bool result = KillPlanner::plan(registry, APP_MEMORY * (apps / 2), false, plan);
+    expect(result && plan.isSatisfied, name, "not satisfied");
+    expect((int)plan.victims.size() == apps / 2, name, "victims(" + to_string(plan.victims.size()) + ")");
+
+    auto it = registry.rbegin();
+    for (int i = 0; i < apps / 2 && it != registry.rend(); ++i, ++it) {
+        string appId = (*it)->getAppId();
+        if (find(plan.victims.begin(), plan.victims.end(), appId) == plan.victims.end()) {
+            expect(false, name, "missing victim " + appId);
+            break;
+        }
+    }
+}
+
+// A single large application is cheaper than hundreds of small ones.
+// Sums of their costs exceed 32 bits.
+static void testSingleLarge(int apps)
+{
+    // With fewer applications, the small ones together cost less
+    if (apps < 100)
+        return;
+
+    string name = "singleLarge(" + to_string(apps) + ")";
+    ApplicationRegistry registry;
+    populate(registry, apps);
+
+    // The highest priority background application
+    auto it = registry.begin();
+    ++it;
+    Application& large = **it;
+    large.setMemory(APP_MEMORY * apps * 1024L);
+
+    KillPlan plan;
+    bool result = KillPlanner::plan(registry, APP_MEMORY * (apps / 2), false, plan);
+    expect(result && plan.isSatisfied, name, "not satisfied");
+    expect(plan.victims.size() == 1 && plan.victims[0] == large.getAppId(), name,
+           "victims(" + to_string(plan.victims.size()) + ")");
+}
+
+// Only the foreground application is left out
+static void testWithoutForeground(int apps)
+{
+    string name = "withoutForeground(" + to_string(apps) + ")";
+    ApplicationRegistry registry;
+    populate(registry, apps);
+
+    KillPlan plan;
+    bool result = KillPlanner::plan(registry, APP_MEMORY * (apps - 1), true, plan);
+    expect(result && plan.isSatisfied, name, "not satisfied");
+    expect((int)plan.victims.size() == apps - 1, name, "victims(" + to_string(plan.victims.size()) + ")");
+    for (auto it = plan.victims.begin(); it != plan.victims.end(); ++it) {
+        expect(*it != "com.test.app0", name, "foreground is chosen");
+    }
+}
+
+// More than all candidates together. The lowest priority one is closed.
+static void testNotEnough(int apps)
+{
+    string name = "notEnough(" + to_string(apps) + ")";
+    ApplicationRegistry registry;
+    populate(registry, apps);
+
+    KillPlan plan;
+    bool result = KillPlanner::plan(registry, APP_MEMORY * apps * 2, false, plan);
+    expect(result && !plan.isSatisfied, name, "satisfied");
+    expect(plan.victims.size() == 1 && plan.victims[0] == registry.back().getAppId(), name, "not the lowest one");
+}
+
+int main(int argc, char** argv)
+{
+    static const int APP_COUNTS[] = { 10, 100, 1000 };
+
+    Logger::getInstance().setLevel(LogLevel_ERROR);
+    for (size_t i = 0; i < sizeof(APP_COUNTS) / sizeof(APP_COUNTS[0]); ++i) {
+        testLowestFirst(APP_COUNTS[i]);
+        testAll(APP_COUNTS[i]);
+        testLowerHalf(APP_COUNTS[i]);
+        testSingleLarge(APP_COUNTS[i]);
+        testWithoutForeground(APP_COUNTS[i]);
+        testNotEnough(APP_COUNTS[i]);
+    }
+
+    if (s_failures > 0) {
+        cerr << "[test] " << s_failures << " failures" << endl;
+        return 1;
+    }
+    cout << "[test] KillPlanner passed" << endl;
+    return 0;
+}